@@ -8,9 +8,12 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/time.h>
+#include <unistd.h>
 #include "sort.h"
 
 #define LESS_RANDOM 0
@@ -118,6 +121,14 @@ signed compareUnsigned(unsigned * const a, unsigned * const b, void *context) {
 	return *a < *b ? -1 : *a > *b ? 1 : 0;
 }
 
+uint64_t radixKeyStabilityTestingUnsigned(unsigned * const a, void *context) {
+	return *a >> 8;
+}
+
+signed compareFewKeysUnsigned(unsigned * const a, unsigned * const b, void *context) {
+	return (signed)(*a >> 30) - (signed)(*b >> 30);
+}
+
 //unsigned isLessString(char ** const a, char ** const b, void *context) {
 //	return strcmp(*a, *b) < 0;
 //}
@@ -126,6 +137,45 @@ signed compareString(char ** const a, char ** const b, void *context) {
 	return strcmp(*a, *b);
 }
 
+//	MARK: - Inline
+
+#define SORT_NAME Unsigned
+#define SORT_TYPE unsigned
+#define SORT_IS_LESS(a, b) ((a) < (b))
+#include "sortinline.h"
+
+#define SORT_NAME StabilityTestingUnsigned
+#define SORT_TYPE unsigned
+#define SORT_IS_LESS(a, b) (((a) >> 8) < ((b) >> 8))
+#include "sortinline.h"
+
+#define SORT_NAME FewKeysUnsigned
+#define SORT_TYPE unsigned
+#define SORT_IS_LESS(a, b) (((a) >> 30) < ((b) >> 30))
+#include "sortinline.h"
+
+#define SORT_NAME String
+#define SORT_TYPE char *
+#define SORT_IS_LESS(a, b) (strcmp(a, b) < 0)
+#include "sortinline.h"
+
+typedef void InlineBinaryInsertionSort(void *array, size_t count, size_t sorted, void *context);
+typedef void InlineColeSort(void *array, void *buffer, size_t count, void *context);
+typedef void InlineBalancingQuickSort(void *array, size_t count, unsigned imbalances, void *context);
+
+struct InlineSorting {
+	InlineBinaryInsertionSort *binaryInsertionSort;
+	InlineColeSort *coleSort;
+	InlineBalancingQuickSort *balancingQuickSort;
+	Compare *networkCompare;	//	primitive key compare recognized by the sorting networks
+	RadixKey *radixKey;
+	size_t radixKeyWidth;
+};
+
+struct InlineSorting const inlineSortingUnsigned = {(InlineBinaryInsertionSort *)binaryInsertionSortUnsigned, (InlineColeSort *)coleSortUnsigned, (InlineBalancingQuickSort *)balancingQuickSortUnsigned, compareUInt32, NULL, 4};
+struct InlineSorting const inlineSortingStabilityTestingUnsigned = {(InlineBinaryInsertionSort *)binaryInsertionSortStabilityTestingUnsigned, (InlineColeSort *)coleSortStabilityTestingUnsigned, (InlineBalancingQuickSort *)balancingQuickSortStabilityTestingUnsigned, NULL, (RadixKey *)radixKeyStabilityTestingUnsigned, 3};
+struct InlineSorting const inlineSortingString = {(InlineBinaryInsertionSort *)binaryInsertionSortString, (InlineColeSort *)coleSortString, (InlineBalancingQuickSort *)balancingQuickSortString, NULL, NULL, 0};
+
 void populateRandomIntegerArray(unsigned *array, unsigned count) {
 	unsigned index, limit = 2;
 	
@@ -228,6 +278,37 @@ void populateIntegerArray(unsigned *array, unsigned count, unsigned length, unsi
 	}
 }
 
+void populateInterleavedIntegerArray(unsigned *array, unsigned count, unsigned length) {
+	unsigned step = 8;
+	unsigned index, value = 0;
+	
+	//	ascending chunks that each start a little behind where the prior chunk ended, like logs gathered from several sources
+	for ( index = 0 ; index < count ; ++index ) {
+		if ( index % length == 0 ) { value = index / length * length * 3; }
+		
+		value += randomValueUniform(step);
+		array[index] = value;
+	}
+}
+
+double populateRunLengthIntegerArray(unsigned *array, unsigned count) {
+	unsigned step = 8, bits = (unsigned)log2((double)count);
+	unsigned index, limit, value;
+	double entropy = 0;
+	
+	//	ascending runs with lengths spread over every power of two, returns the merge cost bound of n times the entropy of the run lengths
+	for ( index = 0 ; index < count ; index = limit ) {
+		limit = index + 1 + randomValueUniform(1u << randomValueUniform(bits + 1));
+		limit = limit < count ? limit : count;
+		value = randomValueUniform(count * 2);
+		entropy += (limit - index) * log2((double)count / (limit - index));
+		
+		for ( ; index < limit ; ++index ) { array[index] = value; value += randomValueUniform(step); }
+	}
+	
+	return entropy;
+}
+
 unsigned *allocateRandomIntegerArray(unsigned count) {
 	unsigned *array = malloc(count * sizeof(unsigned));
 	
@@ -304,10 +385,29 @@ void sortingStatisticsDisplay(char const *name, struct SortingStatistics *statis
 	}
 }
 
-void sortingComparison(void const *original, size_t count, size_t size, Compare compare, void *context, Compare stableCompare, void *stableContext) {
-	long timeSum, timeBest;
+void sortingGapDisplay(char const *name, long counted, long uncounted, size_t count) {
+	double seconds = (double)uncounted / 1000000.0;
+	double gap = counted > 0 ? 100.0 * (double)(counted - uncounted) / (double)counted : 0.0;
+	int precision = count > 1000 ? 9 - (int)floor(log10((double)count)) : 6;
+	printf("%25s %21s = %8.*f @ %8.1f %% faster\n", name, "", precision, seconds, gap);
+}
+
+void sampleSortTimingsDisplay(struct SampleSortTimings const *timings, size_t count) {
+	if ( count >= 100000 ) {
+		printf("%25s %21s   sample %ld classify %ld scatter %ld sort %ld µs\n", "", "", timings->sampling, timings->classifying, timings->scattering, timings->sorting);
+	}
+}
+
+void externalSortTimingsDisplay(struct ExternalSortTimings const *timings) {
+	printf("%25s %21s   %ld runs form %ld µs (sort %ld µs) read %ld written %ld KiB\n", "", "", timings->runs, timings->forming, timings->sorting, timings->formingBytesRead >> 10, timings->formingBytesWritten >> 10);
+	printf("%25s %21s   %ld passes merge %ld µs read %ld written %ld KiB\n", "", "", timings->passes, timings->merging, timings->mergingBytesRead >> 10, timings->mergingBytesWritten >> 10);
+}
+
+void sortingComparison(void const *original, size_t count, size_t size, Compare compare, void *context, Compare stableCompare, void *stableContext, struct InlineSorting const *inlineSorting) {
+	long timeSum, timeBest, timeCounted;
 	long trial, repetitions = 3;
 	struct SortingStatistics s = {};
+	struct SampleSortTimings timings = {};
 	size_t bytes = (count > 4 ? count : 4) * size;
 	bytes += -bytes & 0x00FF;
 	void *buffer = malloc(bytes * 2);
@@ -334,6 +434,24 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
 			printf("•• binaryInsertionSort not stable\n");
 		}
+		
+		if ( inlineSorting ) {
+			timeCounted = timeBest;
+			for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+				memcpy(array, original, count * size);
+				sortingStatisticsReset(&s);
+				inlineSorting->binaryInsertionSort(array, count, 1, context);
+				sortingStatisticsEnded(&s);
+				timeSum += s.timerEnded - s.timerBegan;
+				if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+			}
+			sortingGapDisplay("inline binaryInsertion", timeCounted, timeBest, count);
+			if ( !isAscending(array, count, size, compare, context) ) {
+				printf("•• inline binaryInsertionSort not ascending\n");
+			} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+				printf("•• inline binaryInsertionSort not stable\n");
+			}
+		}
 	}
 	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
@@ -350,7 +468,95 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		printf("•• quickSort not ascending\n");
 	}
 	
-	if ( 0 ) {
+	timeCounted = timeBest;
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		quickSortUncounted(array, count, size, buffer, NULL, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	sortingGapDisplay("~=~ quickSortUncounted", timeCounted, timeBest, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• quickSortUncounted not ascending\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		patternDefeatingQuickSort(array, count, size, buffer, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("~=~ patternDefeatingQuick", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• patternDefeatingQuickSort not ascending\n");
+	}
+	
+	timeCounted = timeBest;
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		patternDefeatingQuickSortUncounted(array, count, size, buffer, NULL, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	sortingGapDisplay("~=~ patternQuickUncounted", timeCounted, timeBest, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• patternDefeatingQuickSortUncounted not ascending\n");
+	}
+	
+	if ( 1 ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			threeWayQuickSort(array, count, size, buffer, &s, compare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("~=~ threeWayQuickSort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• threeWayQuickSort not ascending\n");
+		}
+	}
+	
+	if ( inlineSorting && inlineSorting->networkCompare ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			quickSort(array, count, size, buffer, &s, inlineSorting->networkCompare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("~=~ quickSort network", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• quickSort network not ascending\n");
+		}
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		parallelBalancingQuickSort(array, count, size, 0, 4, buffer, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("~=~ parallelBalancingQuick", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• parallelBalancingQuickSort not ascending\n");
+	}
+	
+	if ( inlineSorting ) {
 		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 			memcpy(array, original, count * size);
 			sortingStatisticsReset(&s);
@@ -364,6 +570,20 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		if ( !isAscending(array, count, size, compare, context) ) {
 			printf("•• balancingQuickSort not ascending\n");
 		}
+		
+		timeCounted = timeBest;
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			inlineSorting->balancingQuickSort(array, count, 0, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		sortingGapDisplay("~=~ inline balancingQuick", timeCounted, timeBest, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• inline balancingQuickSort not ascending\n");
+		}
 	}
 	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
@@ -418,6 +638,38 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		}
 	}
 	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		blockMergeSort(array, count, size, buffer, (1 + (size_t)sqrt((double)count)) * size, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("blockMergeSort", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• blockMergeSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• blockMergeSort not stable\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		blockMergeSort(array, count, size, NULL, 0, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("inPlaceBlockMergeSort", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• inPlaceBlockMergeSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• inPlaceBlockMergeSort not stable\n");
+	}
+	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 		memcpy(array, original, count * size);
 		sortingStatisticsReset(&s);
@@ -434,6 +686,303 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		printf("•• coleSort not stable\n");
 	}
 	
+	timeCounted = timeBest;
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		coleSortUncounted(array, buffer, count, size, NULL, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	sortingGapDisplay("coleSortUncounted", timeCounted, timeBest, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• coleSortUncounted not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• coleSortUncounted not stable\n");
+	}
+	
+	if ( inlineSorting ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			inlineSorting->coleSort(array, buffer, count, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		sortingGapDisplay("inline coleSort", timeCounted, timeBest, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• inline coleSort not ascending\n");
+		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+			printf("•• inline coleSort not stable\n");
+		}
+	}
+	
+	if ( inlineSorting && inlineSorting->networkCompare ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			coleSort(array, buffer, count, size, &s, inlineSorting->networkCompare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("coleSort network", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• coleSort network not ascending\n");
+		}
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		halfColeSort(array, buffer, count, size, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("halfColeSort", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• halfColeSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• halfColeSort not stable\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		powerColeSort(array, buffer, count, size, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("powerColeSort", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• powerColeSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• powerColeSort not stable\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		parallelColeSort(array, buffer, count, size, 4, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("parallelColeSort", &s, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• parallelColeSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• parallelColeSort not stable\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		parallelSampleSort(array, buffer, count, size, 4, 1, &timings, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("parallelSampleSort", &s, count);
+	sampleSortTimingsDisplay(&timings, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• parallelSampleSort not ascending\n");
+	} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+		printf("•• parallelSampleSort not stable\n");
+	}
+	
+	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		parallelSampleSort(array, buffer, count, size, 4, 0, &timings, &s, compare, context);
+		sortingStatisticsEnded(&s);
+		timeSum += s.timerEnded - s.timerBegan;
+		if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+	}
+	s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+	sortingStatisticsDisplay("~=~ parallelSampleQuick", &s, count);
+	sampleSortTimingsDisplay(&timings, count);
+	if ( !isAscending(array, count, size, compare, context) ) {
+		printf("•• parallelSampleSort unstable not ascending\n");
+	}
+	
+	if ( inlineSorting && inlineSorting->radixKeyWidth ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			if ( inlineSorting->radixKey ) {
+				radixKeySort(array, buffer, count, size, inlineSorting->radixKeyWidth, &s, inlineSorting->radixKey, context);
+			} else {
+				radixSort(array, buffer, count, size, 0, inlineSorting->radixKeyWidth, &s);
+			}
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("radixSort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• radixSort not ascending\n");
+		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+			printf("•• radixSort not stable\n");
+		}
+	}
+	
+	if ( 1 ) {
+		uint32_t *indices = malloc(count * sizeof(uint32_t) * 2);
+		
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			coleArgsort(array, indices, indices + count, count, size, sizeof(uint32_t), &s, compare, context);
+			applyPermutation(array, indices, count, size, sizeof(uint32_t), buffer, &s);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("coleArgsort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• coleArgsort not ascending\n");
+		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+			printf("•• coleArgsort not stable\n");
+		}
+		
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			quickArgsort(array, indices, count, size, sizeof(uint32_t), &s, compare, context);
+			applyPermutation(array, indices, count, size, sizeof(uint32_t), buffer, &s);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("quickArgsort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• quickArgsort not ascending\n");
+		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+			printf("•• quickArgsort not stable\n");
+		}
+		
+		if ( inlineSorting && inlineSorting->radixKeyWidth && !inlineSorting->radixKey ) {
+			for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+				memcpy(array, original, count * size);
+				sortingStatisticsReset(&s);
+				radixArgsort(array, indices, indices + count, count, size, sizeof(uint32_t), 0, inlineSorting->radixKeyWidth, &s);
+				applyPermutation(array, indices, count, size, sizeof(uint32_t), buffer, &s);
+				sortingStatisticsEnded(&s);
+				timeSum += s.timerEnded - s.timerBegan;
+				if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+			}
+			s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+			sortingStatisticsDisplay("radixArgsort", &s, count);
+			if ( !isAscending(array, count, size, compare, context) ) {
+				printf("•• radixArgsort not ascending\n");
+			}
+		}
+		
+		free(indices);
+	}
+	
+	if ( 1 ) {
+		size_t index, *order = malloc(count * sizeof(size_t));
+		uint32_t *indices = malloc(count * sizeof(uint32_t) * 2);
+		void *temporary = malloc(size > sizeof(size_t) ? size : sizeof(size_t));
+		struct SortingPayload payload = {order, sizeof(size_t)};
+		
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			for ( index = 0 ; index < count ; ++index ) { order[index] = index; }
+			sortingStatisticsReset(&s);
+			coleSortPayloads(array, indices, indices + count, count, size, sizeof(uint32_t), &payload, 1, temporary, &s, compare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("coleSortPayloads", &s, count);
+		for ( index = 0 ; index < count && !memcmp(array + index * size, original + order[index] * size, size) ; ++index ) {}
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• coleSortPayloads not ascending\n");
+		} else if ( index < count ) {
+			printf("•• coleSortPayloads payload not moved with keys\n");
+		} else if ( stableCompare && !isAscending(array, count, size, stableCompare, stableContext) ) {
+			printf("•• coleSortPayloads not stable\n");
+		}
+		
+		if ( inlineSorting && inlineSorting->radixKeyWidth && !inlineSorting->radixKey ) {
+			for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+				memcpy(array, original, count * size);
+				for ( index = 0 ; index < count ; ++index ) { order[index] = index; }
+				sortingStatisticsReset(&s);
+				radixSortPayloads(array, indices, indices + count, count, size, sizeof(uint32_t), 0, inlineSorting->radixKeyWidth, &payload, 1, temporary, &s);
+				sortingStatisticsEnded(&s);
+				timeSum += s.timerEnded - s.timerBegan;
+				if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+			}
+			s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+			sortingStatisticsDisplay("radixSortPayloads", &s, count);
+			for ( index = 0 ; index < count && !memcmp(array + index * size, original + order[index] * size, size) ; ++index ) {}
+			if ( !isAscending(array, count, size, compare, context) ) {
+				printf("•• radixSortPayloads not ascending\n");
+			} else if ( index < count ) {
+				printf("•• radixSortPayloads payload not moved with keys\n");
+			}
+			for ( index = 1 ; index < count && (order[index - 1] < order[index] || compare(array + (index - 1) * size, array + index * size, context)) ; ++index ) {}
+			if ( index < count ) {
+				printf("•• radixSortPayloads not stable\n");
+			}
+		}
+		
+		free(temporary);
+		free(indices);
+		free(order);
+	}
+	
+	if ( inlineSorting == &inlineSortingString ) {
+		void *prefixes = malloc(count * kStringPrefixBufferSize);
+		
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			stringSort(array, buffer, count, &s);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("stringSort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• stringSort not ascending\n");
+		}
+		
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			stringPrefixSort(array, prefixes, count, &s, compare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("stringPrefixSort", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• stringPrefixSort not ascending\n");
+		}
+		
+		free(prefixes);
+	}
+	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 		memcpy(array, original, count * size);
 		sortingStatisticsReset(&s);
@@ -483,6 +1032,22 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 			printf("•• polymergeSort not stable\n");
 		}
 		
+		if ( inlineSorting && inlineSorting->networkCompare ) {
+			for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+				memcpy(array, original, count * size);
+				sortingStatisticsReset(&s);
+				polymergeSort(array, buffer, count, size, &s, inlineSorting->networkCompare, context);
+				sortingStatisticsEnded(&s);
+				timeSum += s.timerEnded - s.timerBegan;
+				if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+			}
+			s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+			sortingStatisticsDisplay("polymergeSort network", &s, count);
+			if ( !isAscending(array, count, size, compare, context) ) {
+				printf("•• polymergeSort network not ascending\n");
+			}
+		}
+		
 		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 			memcpy(array, original, count * size);
 			sortingStatisticsReset(&s);
@@ -516,6 +1081,22 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		printf("•• mergeFourSort not stable\n");
 	}
 	
+	if ( inlineSorting && inlineSorting->networkCompare ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			mergeFourSort(array, buffer, count, size, &s, inlineSorting->networkCompare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("mergeFourSort network", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• mergeFourSort network not ascending\n");
+		}
+	}
+	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 		memcpy(array, original, count * size);
 		sortingStatisticsReset(&s);
@@ -532,6 +1113,22 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 		printf("•• bottomUpMergeFourSort not stable\n");
 	}
 	
+	if ( inlineSorting && inlineSorting->networkCompare ) {
+		for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
+			memcpy(array, original, count * size);
+			sortingStatisticsReset(&s);
+			bottomUpMergeFourSort(array, buffer, count, size, &s, inlineSorting->networkCompare, context);
+			sortingStatisticsEnded(&s);
+			timeSum += s.timerEnded - s.timerBegan;
+			if ( s.timerEnded - s.timerBegan < timeBest ) { timeBest = s.timerEnded - s.timerBegan; }
+		}
+		s.timerEnded = s.timerBegan + timeBest;//timeSum / repetitions;
+		sortingStatisticsDisplay("bottomUpMergeFour network", &s, count);
+		if ( !isAscending(array, count, size, compare, context) ) {
+			printf("•• bottomUpMergeFourSort network not ascending\n");
+		}
+	}
+	
 	for ( timeBest = LONG_MAX, timeSum = 0, trial = 0 ; trial < repetitions ; ++trial ) {
 		memcpy(array, original, count * size);
 		sortingStatisticsReset(&s);
@@ -551,16 +1148,377 @@ void sortingComparison(void const *original, size_t count, size_t size, Compare
 	free(buffer);
 }
 
+struct SortingRecord {
+	unsigned key;
+	unsigned order;
+	char payload[248];
+};
+
+signed compareSortingRecord(struct SortingRecord const *a, struct SortingRecord const *b, void *context) {
+	return (a->key > b->key) - (a->key < b->key);
+}
+
+signed compareSortingRecordOrder(struct SortingRecord const *a, struct SortingRecord const *b, void *context) {
+	return a->key != b->key ? (a->key > b->key) - (a->key < b->key) : (a->order > b->order) - (a->order < b->order);
+}
+
+signed compareThreeByteKey(uint8_t const *a, uint8_t const *b, void *context) {
+	uint32_t ka = a[1] | a[2] << 8 | (uint32_t)a[3] << 16, kb = b[1] | b[2] << 8 | (uint32_t)b[3] << 16;
+	
+	return (ka > kb) - (ka < kb);
+}
+
+///	Radix sort four byte elements by a three byte key that ends each element, with a noise byte in front that must not affect the order
+void radixKeyWidthComparison(size_t count) {
+	size_t index, size = 4;
+	uint8_t *original = malloc(count * size);
+	uint8_t *array = malloc(count * size);
+	uint8_t *sorted = malloc(count * size);
+	uint8_t *buffer = malloc(count * size);
+	uint32_t *indices = malloc(count * sizeof(uint32_t) * 2);
+	uint32_t *expected = malloc(count * sizeof(uint32_t) * 2);
+	Compare *compare = (Compare *)compareThreeByteKey;
+	struct SortingStatistics s;
+	
+	for ( index = 0 ; index < count * size ; ++index ) {
+		original[index] = (uint8_t)randomValueUniform(index % size == 1 ? 256 : index % size == 3 ? 2 : 4);
+	}
+	
+	memcpy(sorted, original, count * size);
+	coleSort(sorted, buffer, count, size, NULL, compare, NULL);
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	radixSort(array, buffer, count, size, 1, 3, &s);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("radixSort 3 byte key", &s, count);
+	if ( !isAscending(array, count, size, compare, NULL) ) {
+		printf("•• radixSort 3 byte key not ascending\n");
+	} else if ( memcmp(array, sorted, count * size) ) {
+		printf("•• radixSort 3 byte key not stable\n");
+	}
+	
+	coleArgsort(original, expected, expected + count, count, size, sizeof(uint32_t), NULL, compare, NULL);
+	sortingStatisticsReset(&s);
+	radixArgsort(original, indices, indices + count, count, size, sizeof(uint32_t), 1, 3, &s);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("radixArgsort 3 byte key", &s, count);
+	if ( memcmp(indices, expected, count * sizeof(uint32_t)) ) {
+		printf("•• radixArgsort 3 byte key not stable\n");
+	}
+	
+	free(expected);
+	free(indices);
+	free(buffer);
+	free(sorted);
+	free(array);
+	free(original);
+}
+
+///	Compare sorting large records directly with sorting an index permutation and moving each record once
+void recordSortingComparison(size_t count) {
+	size_t index, size = sizeof(struct SortingRecord);
+	struct SortingRecord *original = calloc(count, size);
+	struct SortingRecord *array = malloc(count * size);
+	struct SortingRecord *buffer = malloc(count * size);
+	uint32_t *indices = malloc(count * sizeof(uint32_t) * 2);
+	Compare *compare = (Compare *)compareSortingRecord;
+	Compare *stableCompare = (Compare *)compareSortingRecordOrder;
+	struct SortingStatistics s;
+	
+	for ( index = 0 ; index < count ; ++index ) {
+		original[index].key = randomValueUniform((uint32_t)count / 4);
+		original[index].order = (unsigned)index;
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	coleSort(array, buffer, count, size, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("record coleSort", &s, count);
+	if ( !isAscending(array, count, size, stableCompare, NULL) ) {
+		printf("•• record coleSort not stable\n");
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	coleArgsort(array, indices, indices + count, count, size, sizeof(uint32_t), &s, compare, NULL);
+	applyPermutation(array, indices, count, size, sizeof(uint32_t), buffer, &s);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("record coleArgsort", &s, count);
+	if ( !isAscending(array, count, size, stableCompare, NULL) ) {
+		printf("•• record coleArgsort not stable\n");
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	radixSort(array, buffer, count, size, 0, sizeof(unsigned), &s);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("record radixSort", &s, count);
+	if ( !isAscending(array, count, size, stableCompare, NULL) ) {
+		printf("•• record radixSort not stable\n");
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	radixArgsort(array, indices, indices + count, count, size, sizeof(uint32_t), 0, sizeof(unsigned), &s);
+	applyPermutation(array, indices, count, size, sizeof(uint32_t), buffer, &s);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("record radixArgsort", &s, count);
+	if ( !isAscending(array, count, size, stableCompare, NULL) ) {
+		printf("•• record radixArgsort not stable\n");
+	}
+	
+	free(indices);
+	free(buffer);
+	free(array);
+	free(original);
+}
+
+///	Compare sorting the whole array after each batch of appended elements with sorting only the batch and merging it into the sorted prefix
+void appendSortingComparison(size_t count, size_t batch) {
+	size_t round, rounds = 16, total = count + batch * rounds, size = sizeof(unsigned);
+	unsigned *original = malloc(total * size);
+	unsigned *array = malloc(total * size);
+	unsigned *buffer = malloc(total * size);
+	Compare *compare = (Compare *)compareUnsigned;
+	struct SortingStatistics s;
+	
+	populateRandomIntegerArray(original, (unsigned)total);
+	coleSort(original, buffer, count, size, NULL, compare, NULL);
+	
+	memcpy(array, original, total * size);
+	sortingStatisticsReset(&s);
+	for ( round = 1 ; round <= rounds ; ++round ) {
+		coleSort(array, buffer, count + batch * round, size, &s, compare, NULL);
+	}
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("append coleSort", &s, total);
+	if ( !isAscending(array, total, size, compare, NULL) ) {
+		printf("•• append coleSort not ascending\n");
+	}
+	
+	memcpy(array, original, total * size);
+	sortingStatisticsReset(&s);
+	for ( round = 1 ; round <= rounds ; ++round ) {
+		coleSortAppended(array, buffer, count + batch * round, size, count + batch * (round - 1), &s, compare, NULL);
+	}
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("coleSortAppended", &s, total);
+	if ( !isAscending(array, total, size, compare, NULL) ) {
+		printf("•• coleSortAppended not ascending\n");
+	}
+	
+	free(buffer);
+	free(array);
+	free(original);
+}
+
+///	Compare sorting the whole array with sorting only the least k elements
+void partialSortingComparison(size_t count) {
+	size_t index, k, size = sizeof(unsigned);
+	size_t ks[] = {10, 1000, count / 10};
+	unsigned *original = malloc(count * size);
+	unsigned *array = malloc(count * size);
+	unsigned *sorted = malloc(count * size);
+	unsigned temporary;
+	Compare *compare = (Compare *)compareUnsigned;
+	struct SortingStatistics s;
+	char name[32];
+	
+	populateRandomIntegerArray(original, (unsigned)count);
+	
+	memcpy(sorted, original, count * size);
+	sortingStatisticsReset(&s);
+	coleSort(sorted, array, count, size, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("coleSort", &s, count);
+	
+	for ( index = 0 ; index < countof(ks) ; ++index ) {
+		k = ks[index];
+		snprintf(name, sizeof name, "partialSort %zu", k);
+		memcpy(array, original, count * size);
+		sortingStatisticsReset(&s);
+		partialSort(array, count, k, size, &temporary, &s, compare, NULL);
+		sortingStatisticsEnded(&s);
+		sortingStatisticsDisplay(name, &s, count);
+		if ( memcmp(array, sorted, k * size) ) {
+			printf("•• %s not the least elements in order\n", name);
+		}
+	}
+	
+	free(sorted);
+	free(array);
+	free(original);
+}
+
+///	Whether no element before nth is greater and no element after nth is less than the element at nth
+unsigned isSelectedUnsigned(unsigned const *array, size_t count, size_t nth) {
+	size_t index;
+	
+	for ( index = 0 ; index < count && (index < nth ? array[index] <= array[nth] : array[nth] <= array[index]) ; ++index ) {}
+	
+	return index == count;
+}
+
+///	Compare sorting the whole array with placing only the 50th, 90th and 99th percentiles, one at a time or all at once
+void selectionSortingComparison(size_t count) {
+	size_t index, size = sizeof(unsigned);
+	size_t nths[] = {count / 2, count * 9 / 10, count * 99 / 100};
+	unsigned *original = malloc(count * size);
+	unsigned *array = malloc(count * size);
+	unsigned *sorted = malloc(count * size);
+	unsigned temporary;
+	Compare *compare = (Compare *)compareUnsigned;
+	struct SortingStatistics s;
+	
+	populateRandomIntegerArray(original, (unsigned)count);
+	
+	memcpy(sorted, original, count * size);
+	sortingStatisticsReset(&s);
+	coleSort(sorted, array, count, size, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("coleSort", &s, count);
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	quickSelect(array, count, nths[0], size, &temporary, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("quickSelect p50", &s, count);
+	if ( array[nths[0]] != sorted[nths[0]] || !isSelectedUnsigned(array, count, nths[0]) ) {
+		printf("•• quickSelect p50 not selected\n");
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	for ( index = 0 ; index < countof(nths) ; ++index ) {
+		quickSelect(array, count, nths[index], size, &temporary, &s, compare, NULL);
+	}
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("quickSelect p50 p90 p99", &s, count);
+	for ( index = 0 ; index < countof(nths) ; ++index ) {
+		if ( array[nths[index]] != sorted[nths[index]] ) {
+			printf("•• quickSelect p50 p90 p99 not selected\n");
+			break;
+		}
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	quickMultiSelect(array, count, nths, countof(nths), size, &temporary, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("quickMultiSelect", &s, count);
+	for ( index = 0 ; index < countof(nths) ; ++index ) {
+		if ( array[nths[index]] != sorted[nths[index]] || !isSelectedUnsigned(array, count, nths[index]) ) {
+			printf("•• quickMultiSelect not selected\n");
+			break;
+		}
+	}
+	
+	free(sorted);
+	free(array);
+	free(original);
+}
+
+///	Sort a file of records through temporary run files with a memory budget smaller than the file and compare with sorting in memory
+void externalSortingComparison(size_t count, size_t memory) {
+	size_t index, size = sizeof(struct SortingRecord);
+	struct SortingRecord *original = calloc(count, size);
+	struct SortingRecord *array = malloc(count * size);
+	struct SortingRecord *buffer = malloc(count * size);
+	char inputPath[] = "/tmp/scortchXXXXXX";
+	char outputPath[] = "/tmp/scortchXXXXXX";
+	int input = mkstemp(inputPath);
+	int output = mkstemp(outputPath);
+	Compare *compare = (Compare *)compareSortingRecord;
+	struct ExternalSortTimings timings;
+	struct SortingStatistics s;
+	struct rlimit limit, files;
+	FILE *file;
+	
+	for ( index = 0 ; index < count ; ++index ) {
+		original[index].key = randomValueUniform((uint32_t)count / 4);
+		original[index].order = (unsigned)index;
+	}
+	
+	memcpy(array, original, count * size);
+	sortingStatisticsReset(&s);
+	coleSort(array, buffer, count, size, &s, compare, NULL);
+	sortingStatisticsEnded(&s);
+	sortingStatisticsDisplay("coleSort", &s, count);
+	
+	file = input < 0 || output < 0 ? NULL : fdopen(input, "wb");
+	if ( !file || fwrite(original, size, count, file) != count || fclose(file) ) {
+		printf("•• externalSort input not written\n");
+	} else {
+		//	the runs share temporary files, so the sort must not need more descriptors as the runs grow
+		getrlimit(RLIMIT_NOFILE, &limit);
+		files = limit;
+		files.rlim_cur = files.rlim_cur < 16 ? files.rlim_cur : 16;
+		setrlimit(RLIMIT_NOFILE, &files);
+		sortingStatisticsReset(&s);
+		if ( externalSort(inputPath, outputPath, "/tmp", size, memory, &timings, &s, compare, NULL) ) {
+			printf("•• externalSort failed\n");
+		}
+		sortingStatisticsEnded(&s);
+		setrlimit(RLIMIT_NOFILE, &limit);
+		sortingStatisticsDisplay("externalSort", &s, count);
+		externalSortTimingsDisplay(&timings);
+		if ( timings.runs != (long)((count + memory / size / 2 - 1) / (memory / size / 2)) ) {
+			printf("•• externalSort runs miscounted\n");
+		}
+		
+		file = fopen(outputPath, "rb");
+		if ( !file || fread(buffer, size, count, file) != count || fgetc(file) != EOF || memcmp(buffer, array, count * size) ) {
+			printf("•• externalSort not stable\n");
+		}
+		if ( file ) {
+			fclose(file);
+		}
+	}
+	
+	if ( output >= 0 ) {
+		close(output);
+	}
+	unlink(outputPath);
+	unlink(inputPath);
+	free(buffer);
+	free(array);
+	free(original);
+}
+
+///	Inline cole sort of a few distinct keys in the top two bits, the index in the low bits shows whether equal keys kept their order
+void inlineStabilitySortingComparison(size_t count, unsigned keys) {
+	size_t index;
+	unsigned *array = malloc(count * sizeof(unsigned));
+	unsigned *buffer = malloc(count * sizeof(unsigned));
+	
+	for ( index = 0 ; index < count ; ++index ) {
+		array[index] = randomValueUniform(keys) << 30 | (unsigned)index;
+	}
+	
+	coleSortFewKeysUnsigned(array, buffer, count, NULL);
+	if ( !isAscending(array, count, sizeof(unsigned), (Compare *)compareFewKeysUnsigned, NULL) ) {
+		printf("•• inline coleSort few keys not ascending\n");
+	} else if ( !isAscending(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL) ) {
+		printf("•• inline coleSort few keys not stable\n");
+	}
+	
+	free(buffer);
+	free(array);
+}
+
 void sortingTest() {
 	void *array;
 	unsigned index, count, tooth, root;
+	double entropy;
 	unsigned integerArray[] = {6, 3, 5, 99, 44, 37, 9, 66, 15, 69, 85, 1, 57, 19, 22, 98, 24, 73, 11, 13, 7, 42, 17, 23};
 	char const *stringArray[] = {"dog", "cat", "elk", "bat", "fox", "ape", "red", "orange", "yellow", "green", "blue", "indigo", "violet", "azure", "viridian", "cerulean", "teal", "sepia", "umber", "cerise", "sienna", "crimson", "periwinkle"};
 	unsigned integerArrayCounts[] = {102, 1024, 10007, 100003, 1000003, 4000037};
 	unsigned integerArrayCount = countof(integerArrayCounts);
 	unsigned stringArrayCounts[] = {102, 1024, 10007, 100003, 1000003};
 	unsigned stringArrayCount = countof(stringArrayCounts);
-	
+
 #if LESS_RANDOM
 	uint32_t seed = arc4random();
 	srandom(seed);
@@ -570,10 +1528,10 @@ void sortingTest() {
 #endif
 	
 	printf("-- sort small known integerArray %lu\n", countof(integerArray));
-	sortingComparison(integerArray, countof(integerArray), sizeof(integerArray[0]), (Compare *)compareUnsigned, NULL, NULL, NULL);
+	sortingComparison(integerArray, countof(integerArray), sizeof(integerArray[0]), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 	
 	printf("-- sort small known stringArray %lu\n", countof(stringArray));
-	sortingComparison(stringArray, countof(stringArray), sizeof(stringArray[0]), (Compare *)compareString, NULL, NULL, NULL);
+	sortingComparison(stringArray, countof(stringArray), sizeof(stringArray[0]), (Compare *)compareString, NULL, NULL, NULL, &inlineSortingString);
 	
 	for ( index = 1 ; index < 4 ; ++index ) {
 		count = integerArrayCounts[index];
@@ -585,88 +1543,101 @@ void sortingTest() {
 		
 		populateIntegerArray(array, count, count, 01);
 		printf("-- sort equal unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, count, 02);
 		printf("-- sort ascending unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, count, 03);
 		printf("-- sort descending unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, count, 05);
 		printf("-- sort random unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, count, 07);
 		printf("-- sort runless unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 05222);
 		printf("-- sort lead 3/4 ascending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 02225);
 		printf("-- sort tail 3/4 ascending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 05225);
 		printf("-- sort inner 1/2 ascending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 02552);
 		printf("-- sort outer 1/2 ascending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 05333);
 		printf("-- sort lead 3/4 descending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 03335);
 		printf("-- sort tail 3/4 descending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 05335);
 		printf("-- sort inner 1/2 descending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, (count + 3) / 4, 05335);
 		printf("-- sort outer 1/2 descending unsigned array %u [%u]\n", count, (count + 3) / 4);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		tooth = count / (root > 8 ? root >> 2 : 2);
 		populateIntegerArray(array, count, tooth, 015);
 		printf("-- sort alternating random and equal unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 025);
 		printf("-- sort alternating random and ascending unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 035);
 		printf("-- sort alternating random and descending unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 032);
 		printf("-- sort alternating ascending and descending unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 03425);
 		printf("-- sort alternating random equal descending ascending unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 05352);
 		printf("-- sort alternating ascending random descending random unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateIntegerArray(array, count, tooth, 05253);
 		printf("-- sort alternating descending or ascending with random unsigned array %u [%u]\n", count, tooth);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
+		
+		populateInterleavedIntegerArray(array, count, tooth);
+		printf("-- sort overlapping ascending chunks unsigned array %u [%u]\n", count, tooth);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
+		
+		entropy = populateRunLengthIntegerArray(array, count);
+		printf("-- sort random length ascending runs unsigned array %u (n H = %.0f)\n", count, entropy);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		
 		populateStabilityTestingRandomIntegerArray(array, count);
 		printf("-- sort stability testing unsigned array %u\n", count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareStabilityTestingUnsigned, NULL, (Compare *)compareUnsigned, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareStabilityTestingUnsigned, NULL, (Compare *)compareUnsigned, NULL, &inlineSortingStabilityTestingUnsigned);
+		
+		for ( tooth = 2 ; tooth <= 4 ; tooth *= 2 ) {
+			printf("-- inline sort %u keys stability testing unsigned array %u\n", tooth, count);
+			inlineStabilitySortingComparison(count, tooth);
+		}
 		
 		free(array);
 	}
@@ -675,15 +1646,54 @@ void sortingTest() {
 		count = stringArrayCounts[index];
 		array = allocateRandomStringArray(count, 20, 10);
 		printf("-- sort random string array %u (n log2 n = %.0f)\n", count, log2((double)count) * (double)count);
-		sortingComparison(array, count, sizeof(char *), (Compare *)compareString, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(char *), (Compare *)compareString, NULL, NULL, NULL, &inlineSortingString);
 		free(array);
 	}
 	
+	for ( index = 2 ; index < 4 ; ++index ) {
+		count = integerArrayCounts[index];
+		printf("-- sort random %lu byte records %u\n", sizeof(struct SortingRecord), count);
+		recordSortingComparison(count);
+	}
+	
+	for ( index = 3 ; index < 5 ; ++index ) {
+		count = integerArrayCounts[index];
+		printf("-- radix sort 3 byte keys of 4 byte elements %u\n", count);
+		radixKeyWidthComparison(count);
+	}
+	
+	for ( index = 3 ; index < 5 ; ++index ) {
+		count = integerArrayCounts[index];
+		
+		for ( tooth = 10 ; tooth <= 1000 ; tooth *= 100 ) {
+			printf("-- sort 16 batches of %u appended to sorted unsigned array %u\n", tooth, count);
+			appendSortingComparison(count, tooth);
+		}
+	}
+	
+	for ( index = 3 ; index < 5 ; ++index ) {
+		count = integerArrayCounts[index];
+		printf("-- sort least k of random unsigned array %u\n", count);
+		partialSortingComparison(count);
+	}
+	
+	for ( index = 3 ; index < 5 ; ++index ) {
+		count = integerArrayCounts[index];
+		printf("-- select percentiles of random unsigned array %u\n", count);
+		selectionSortingComparison(count);
+	}
+	
+	count = integerArrayCounts[3];
+	for ( tooth = 1 << 14 ; tooth <= 1 << 26 ; tooth <<= 4 ) {
+		printf("-- sort file of %u records %zu KiB with %u KiB memory\n", count, count * sizeof(struct SortingRecord) >> 10, tooth >> 10);
+		externalSortingComparison(count, tooth);
+	}
+	
 	for ( index = 0 ; index < integerArrayCount ; ++index ) {
 		count = integerArrayCounts[index];
 		array = allocateRandomIntegerArray(count);
 		printf("-- sort random unsigned array %u (n log2 n = %.0f)\n", count, log2((double)count) * (double)count);
-		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL);
+		sortingComparison(array, count, sizeof(unsigned), (Compare *)compareUnsigned, NULL, NULL, NULL, &inlineSortingUnsigned);
 		free(array);
 	}
 }
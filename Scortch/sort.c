@@ -7,9 +7,20 @@
 //  eric x cole gmail com
 //
 
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
 #include "sort.h"
 
+#ifndef SORTING_STATISTICS
+#define SORTING_STATISTICS 1	//	0 removes all counting at compile time, see sortuncounted.c
+#endif
+
 struct PointerCount {
 	void const *p;
 	size_t n;
@@ -17,8 +28,8 @@ struct PointerCount {
 
 //	MARK: - Utility
 
-unsigned invokeIsLess(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static inline unsigned invokeIsLess(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 2;
 		statistics->comparisons += 1;
 	}
@@ -26,8 +37,8 @@ unsigned invokeIsLess(void const * a, void const * b, struct SortingStatistics *
 	return compare(a, b, context) < 0;
 }
 
-signed invokeCompare(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static inline signed invokeCompare(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 2;
 		statistics->comparisons += 1;
 	}
@@ -35,8 +46,8 @@ signed invokeCompare(void const * a, void const * b, struct SortingStatistics *s
 	return compare(a, b, context);
 }
 
-unsigned invokeStableIsLess(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static inline unsigned invokeStableIsLess(void const * a, void const * b, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 2;
 		statistics->comparisons += 1;
 	}
@@ -46,28 +57,77 @@ unsigned invokeStableIsLess(void const * a, void const * b, struct SortingStatis
 	return c ? c < 0 : a < b;
 }
 
+///	Wall clock microseconds for the phase timings of parallelSampleSort and externalSort
+static long sortingMicroseconds() {
+	struct timeval t;
+	
+	gettimeofday(&t, NULL);
+	
+	return (long)t.tv_sec * 1000000 + t.tv_usec;
+}
+
+//	MARK: - Sorting Network
+
+///	Sort a block of primitive keys with the vector sorting network from sortnetwork.c, unsorted and sorted may be the same
+static inline void networkSortCounted(void const *unsorted, void *sorted, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare) {
+	size_t comparisons = networkSort(unsorted, sorted, count, size, compare);
+	
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+		statistics->accesses += count * 2;
+		statistics->writes += count;
+		statistics->assignments += count;
+		statistics->comparisons += comparisons;
+	}
+}
+
+///	Merge two sorted runs of primitive keys with the vector merge network from sortnetwork.c, returns zero when the keys are not supported
+static inline unsigned networkMergeCounted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, struct SortingStatistics *statistics, Compare compare) {
+	size_t comparisons = networkMerge(unmerged, merged, count, split, size, compare);
+	
+	if ( SORTING_STATISTICS && statistics && comparisons ) {
+		statistics->invocations += 1;
+		statistics->accesses += count * 2;
+		statistics->writes += count;
+		statistics->assignments += count;
+		statistics->comparisons += comparisons;
+	}
+	
+	return comparisons > 0;
+}
+
 //	MARK: - Data Motion
 
-void accessAt(void *array, size_t from, size_t size, void * to, struct SortingStatistics *statistics) {
-	if ( statistics ) {
+///	Move one element, using native word moves for the common fixed sizes
+static inline void moveElement(void *to, void const *from, size_t size) {
+	switch ( size ) {
+	case 4: memmove(to, from, 4); break;
+	case 8: memmove(to, from, 8); break;
+	case 16: memmove(to, from, 16); break;
+	default: memmove(to, from, size); break;
+	}
+}
+
+static inline void accessAt(void *array, size_t from, size_t size, void * to, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 1;
 	}
 	
-	memmove(to, array + from * size, size);
+	moveElement(to, array + from * size, size);
 }
 
-void assignAt(void *array, size_t to, size_t size, void const * from, struct SortingStatistics *statistics) {
-	if ( statistics ) {
+static inline void assignAt(void *array, size_t to, size_t size, void const * from, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 1;
 		statistics->writes += 1;
 		statistics->assignments += 1;
 	}
 	
-	memmove(array + to * size, from, size);
+	moveElement(array + to * size, from, size);
 }
 
-void assignManyAt(void *array, size_t to, size_t count, size_t size, void const * from, struct SortingStatistics *statistics) {
-	if ( statistics ) {
+static inline void assignManyAt(void *array, size_t to, size_t count, size_t size, void const * from, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += count;
 		statistics->writes += 1;
 		statistics->assignments += count;
@@ -76,20 +136,20 @@ void assignManyAt(void *array, size_t to, size_t count, size_t size, void const
 	memmove(array + to * size, from, count * size);
 }
 
-void swapAt(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
-	if ( statistics ) {
+static inline void swapAt(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 2;
 		statistics->writes += 2;
 		statistics->assignments += 2;
 	}
 	
-	memcpy(temporary, array + from * size, size);
-	memmove(array + from * size, array + to * size, size);
-	memcpy(array + to * size, temporary, size);
+	moveElement(temporary, array + from * size, size);
+	moveElement(array + from * size, array + to * size, size);
+	moveElement(array + to * size, temporary, size);
 }
 
-void swapManyAt(void *array, size_t from, size_t to, size_t count, size_t size, void *buffer, struct SortingStatistics *statistics) {
-	if ( statistics ) {
+static inline void swapManyAt(void *array, size_t from, size_t to, size_t count, size_t size, void *buffer, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += 2 * count;
 		statistics->writes += 3;
 		statistics->assignments += 2 * count;
@@ -103,56 +163,56 @@ void swapManyAt(void *array, size_t from, size_t to, size_t count, size_t size,
 void reverse(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics) {
 	long from, to = count - 1;
 	
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += count & ~1;
 		statistics->writes += count & ~1;
 		statistics->assignments += count & ~1;
 	}
 	
 	for ( from = 0, to = count - 1 ; from < to ; ++from, --to ) {
-		memcpy(temporary, array + from * size, size);
-		memmove(array + from * size, array + to * size, size);
-		memcpy(array + to * size, temporary, size);
+		moveElement(temporary, array + from * size, size);
+		moveElement(array + from * size, array + to * size, size);
+		moveElement(array + to * size, temporary, size);
 	}
 }
 
-void slideDown(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
+static inline void slideDown(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
 	if ( from <= to ) {
 		return;
 	}
 	
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += from - to + 1;
 		statistics->assignments += from - to + 1;
 		statistics->writes += 2;
 	}
 	
-	memcpy(temporary, array + from * size, size);
+	moveElement(temporary, array + from * size, size);
 	memmove(array + (to + 1) * size, array + to * size, (from - to) * size);
-	memcpy(array + to * size, temporary, size);
+	moveElement(array + to * size, temporary, size);
 }
 
-void slideUp(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
+static inline void slideUp(void *array, size_t from, size_t to, size_t size, void *temporary, struct SortingStatistics *statistics) {
 	if ( to <= from ) {
 		return;
 	}
 	
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->accesses += to - from + 1;
 		statistics->assignments += to - from + 1;
 		statistics->writes += 2;
 	}
 	
-	memcpy(temporary, array + from * size, size);
+	moveElement(temporary, array + from * size, size);
 	memmove(array + from * size, array + (from + 1) * size, (to - from) * size);
-	memcpy(array + to * size, temporary, size);
+	moveElement(array + to * size, temporary, size);
 }
 
 //	MARK: - Binary Insertion Sort
 
 ///	Insertion sort that uses a binary search to place each element
 void binaryInsertionSort(void *array, size_t count, size_t size, size_t sorted, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -179,7 +239,7 @@ void binaryInsertionSort(void *array, size_t count, size_t size, size_t sorted,
 }
 
 void binaryMoveSort(void *unsorted, void *sorted, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -207,9 +267,183 @@ void binaryMoveSort(void *unsorted, void *sorted, size_t count, size_t size, str
 	}
 }
 
+//	MARK: - Galloping
+
+#define kGallopMinimum 7
+
+///	Exponential search from the front of a sorted run, counts the leading elements less than key, or not greater than key when inclusive
+static size_t gallopCount(void const *key, void const *run, size_t count, size_t size, unsigned inclusive, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t m = 0, n = 1, o;
+	
+	//	double the probe until it passes key, the answer then lies between the last two probes
+	while ( n <= count && (inclusive ? !invokeIsLess(key, run + (n - 1) * size, statistics, compare, context) : invokeIsLess(run + (n - 1) * size, key, statistics, compare, context)) ) {
+		m = n;
+		n = n * 2 + 1;
+	}
+	
+	n = n - 1 < count ? n - 1 : count;
+	
+	while ( m < n ) {
+		o = m + (n - m) / 2;
+		
+		if ( inclusive ? !invokeIsLess(key, run + o * size, statistics, compare, context) : invokeIsLess(run + o * size, key, statistics, compare, context) ) {
+			m = o + 1;
+		} else {
+			n = o;
+		}
+	}
+	
+	return m;
+}
+
+///	Stable merge of two sorted runs that switches to galloping after a streak of wins from one run, with a threshold that adapts to how well galloping pays off
+static void gallopMergeRuns(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	void const *u = lower, *v = upper;
+	void const *uEnd = lower + lowerCount * size, *vEnd = upper + upperCount * size;
+	void *w = merged;
+	size_t minimum = kGallopMinimum, lowerWins = 0, upperWins = 0, m, n;
+	
+	while ( u < uEnd && v < vEnd ) {
+		if ( invokeIsLess(v, u, statistics, compare, context) ) {
+			assignAt(w, 0, size, v, statistics);
+			v += size;
+			upperWins += 1;
+			lowerWins = 0;
+		} else {
+			assignAt(w, 0, size, u, statistics);
+			u += size;
+			lowerWins += 1;
+			upperWins = 0;
+		}
+		
+		w += size;
+		
+		if ( (lowerWins < minimum && upperWins < minimum) || !(u < uEnd && v < vEnd) ) {
+			continue;
+		}
+		
+		//	gallop while either run keeps contributing long stretches, equal lower elements stay ahead
+		do {
+			m = gallopCount(v, u, (uEnd - u) / size, size, 1, statistics, compare, context);
+			assignManyAt(w, 0, m, size, u, statistics);
+			u += m * size;
+			w += m * size;
+			
+			if ( !(u < uEnd) ) {
+				break;
+			}
+			
+			n = gallopCount(u, v, (vEnd - v) / size, size, 0, statistics, compare, context);
+			assignManyAt(w, 0, n, size, v, statistics);
+			v += n * size;
+			w += n * size;
+			
+			if ( !(v < vEnd) ) {
+				break;
+			}
+			
+			minimum -= minimum > 1;
+		} while ( m >= kGallopMinimum || n >= kGallopMinimum );
+		
+		minimum += 2;
+		lowerWins = 0;
+		upperWins = 0;
+	}
+	
+	assignManyAt(w, 0, (uEnd - u) / size, size, u, statistics);
+	
+	//	merging in place leaves the rest of the upper run where it already is
+	if ( w + (uEnd - u) != v ) {
+		assignManyAt(w + (uEnd - u), 0, (vEnd - v) / size, size, v, statistics);
+	}
+}
+
+///	Exponential search from the back of a sorted run, counts the trailing elements greater than key, or not less than key when inclusive
+static size_t gallopCountBackward(void const *key, void const *run, size_t count, size_t size, unsigned inclusive, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t m = 0, n = 1, o;
+	
+	while ( n <= count && (inclusive ? !invokeIsLess(run + (count - n) * size, key, statistics, compare, context) : invokeIsLess(key, run + (count - n) * size, statistics, compare, context)) ) {
+		m = n;
+		n = n * 2 + 1;
+	}
+	
+	n = n - 1 < count ? n - 1 : count;
+	
+	while ( m < n ) {
+		o = m + (n - m) / 2;
+		
+		if ( inclusive ? !invokeIsLess(run + (count - 1 - o) * size, key, statistics, compare, context) : invokeIsLess(key, run + (count - 1 - o) * size, statistics, compare, context) ) {
+			m = o + 1;
+		} else {
+			n = o;
+		}
+	}
+	
+	return m;
+}
+
+///	Merge two sorted runs from the back, upper may be a buffer while lower and merged share the same start, galloping like gallopMergeRuns
+static void mergeRunsBackward(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t i = lowerCount, j = upperCount, n = lowerCount + upperCount;
+	size_t minimum = kGallopMinimum, lowerWins = 0, upperWins = 0, m, o;
+	
+	while ( i > 0 && j > 0 ) {
+		if ( invokeIsLess(upper + (j - 1) * size, lower + (i - 1) * size, statistics, compare, context) ) {
+			assignAt(merged, --n, size, lower + --i * size, statistics);
+			lowerWins += 1;
+			upperWins = 0;
+		} else {
+			assignAt(merged, --n, size, upper + --j * size, statistics);
+			upperWins += 1;
+			lowerWins = 0;
+		}
+		
+		if ( (lowerWins < minimum && upperWins < minimum) || !(i > 0 && j > 0) ) {
+			continue;
+		}
+		
+		//	equal upper elements stay behind the lower element they tie with
+		do {
+			m = gallopCountBackward(lower + (i - 1) * size, upper, j, size, 1, statistics, compare, context);
+			n -= m;
+			j -= m;
+			assignManyAt(merged, n, m, size, upper + j * size, statistics);
+			
+			if ( !(j > 0) ) {
+				break;
+			}
+			
+			o = gallopCountBackward(upper + (j - 1) * size, lower, i, size, 0, statistics, compare, context);
+			n -= o;
+			i -= o;
+			assignManyAt(merged, n, o, size, lower + i * size, statistics);
+			
+			if ( !(i > 0) ) {
+				break;
+			}
+			
+			minimum -= minimum > 1;
+		} while ( m >= kGallopMinimum || o >= kGallopMinimum );
+		
+		minimum += 2;
+		lowerWins = 0;
+		upperWins = 0;
+	}
+	
+	assignManyAt(merged, 0, j, size, upper, statistics);
+	
+	if ( merged != lower ) {
+		assignManyAt(merged, 0, i, size, lower, statistics);
+	}
+}
+
 //	MARK: - Merge Sort
 
-void inPlaceMergeSorted(void *array, size_t count, size_t split, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+static void inPlaceMergeSorted(void *array, size_t count, size_t split, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
 	size_t merged = 0, swapped = 0;
 	
 	/*
@@ -286,8 +520,8 @@ void inPlaceMergeSorted(void *array, size_t count, size_t split, size_t size, vo
 	}
 }
 
-void mergeSorted(void *array, size_t count, size_t split, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void mergeSorted(void *array, size_t count, size_t split, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -296,32 +530,12 @@ void mergeSorted(void *array, size_t count, size_t split, size_t size, void *buf
 		return;
 	}
 	
-	size_t i, j, n;
-	
 	if ( split * size > space ) {
 		assignManyAt(buffer, 0, count - split, size, array + split * size, statistics);
-		
-		for ( i = 0, j = split, n = 0 ; n < count ; ++n ) {
-			if ( i < split && invokeIsLess(buffer + (count - j - 1) * size, array + (split - i - 1) * size, statistics, compare, context) ) {
-				assignAt(array, count - n - 1, size, array + (split - i - 1) * size, statistics);
-				i += 1;
-			} else {
-				assignAt(array, count - n - 1, size, buffer + (count - j - 1) * size, statistics);
-				j += 1;
-			}
-		}
+		mergeRunsBackward(array, split, buffer, count - split, array, size, statistics, compare, context);
 	} else {
 		assignManyAt(buffer, 0, split, size, array, statistics);
-		
-		for ( i = 0, j = split, n = 0 ; n < count && i < split ; ++n ) {
-			if ( j < count && invokeIsLess(array + j * size, buffer + i * size, statistics, compare, context) ) {
-				assignAt(array, n, size, array + j * size, statistics);
-				j += 1;
-			} else {
-				assignAt(array, n, size, buffer + i * size, statistics);
-				i += 1;
-			}
-		}
+		gallopMergeRuns(buffer, split, array + split * size, count - split, array, size, statistics, compare, context);
 	}
 }
 
@@ -389,8 +603,8 @@ void bottomUpMergeSort(void *array, size_t count, size_t size, size_t width, voi
 
 //	MARK: - Series Merge Sort
 
-size_t seriesMergeSeek(void *array, size_t count, size_t size, size_t minimum, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static size_t seriesMergeSeek(void *array, size_t count, size_t size, size_t minimum, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -449,8 +663,8 @@ void seriesMergeSort(void *array, size_t count, size_t size, void *buffer, size_
 
 //	MARK: - Four Sort
 
-void threeSort(void *array, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void threeSort(void *array, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -471,8 +685,8 @@ void threeSort(void *array, size_t size, void *temporary, struct SortingStatisti
 	}
 }
 
-void fourSort(void *array, size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void fourSort(void *array, size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -524,8 +738,8 @@ void fourSort(void *array, size_t size, void *buffer, struct SortingStatistics *
 	}
 }
 
-void mergeIntoSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void mergeIntoSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -534,37 +748,15 @@ void mergeIntoSorted(void const *unmerged, void *merged, size_t count, size_t sp
 		return;
 	}
 	
-	size_t i, j;
-	const void *u = unmerged, *v = unmerged + split * size;
-	void *w = merged;
-	
-	for ( i = 0, j = split ;; ) {
-		if ( invokeIsLess(v, u, statistics, compare, context) ) {
-			j += 1;
-			assignAt(w, 0, size, v, statistics);
-			v += size;
-			w += size;
-			
-			if ( !(j < count) ) {
-				assignManyAt(w, 0, split - i, size, u, statistics);
-				break;
-			}
-		} else {
-			i += 1;
-			assignAt(w, 0, size, u, statistics);
-			u += size;
-			w += size;
-			
-			if ( !(i < split) ) {
-				assignManyAt(w, 0, count - j, size, v, statistics);
-				break;
-			}
-		}
+	if ( networkMergeCounted(unmerged, merged, count, split, size, statistics, compare) ) {
+		return;
 	}
+	
+	gallopMergeRuns(unmerged, split, unmerged + split * size, count - split, merged, size, statistics, compare, context);
 }
 
-void mergeFourSorted(void *array, void *buffer, size_t count, size_t width, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void mergeFourSorted(void *array, void *buffer, size_t count, size_t width, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -663,10 +855,13 @@ void mergeFourSorted(void *array, void *buffer, size_t count, size_t width, size
 }
 
 void mergeFourSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	size_t index, width;
+	size_t index, width, network = networkSortWidth(size, compare);
 	
 	if ( count <= 1 ) {
 		return;
+	} else if ( count <= network ) {
+		networkSortCounted(array, array, count, size, statistics, compare);
+		return;
 	} else if ( count <= 16 ) {
 		width = 4;
 		
@@ -694,27 +889,35 @@ void mergeFourSort(void *array, void *buffer, size_t count, size_t size, struct
 
 ///	Bottom up merge sort that quadruples instead of doubles at each iteration
 void bottomUpMergeFourSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
-	size_t block, index, limit, width = 4;
+	size_t block, index, limit, network = networkSortWidth(size, compare), width = network ? network : 4;
 	void *p;
 	
-	for ( index = 0, p = array ; index + width <= count ; index += width, p += width * size ) {
-		fourSort(p, size, buffer, statistics, compare, context);
-	}
-	
-	switch ( count % 4 ) {
-	case 2:
-		if ( invokeIsLess(p + size, p, statistics, compare, context) ) {
-			swapAt(p, 0, 1, size, buffer, statistics);
+	if ( network ) {
+		for ( index = 0, p = array ; index < count ; index += width, p += width * size ) {
+			limit = count - index < width ? count - index : width;
+			
+			networkSortCounted(p, p, limit, size, statistics, compare);
+		}
+	} else {
+		for ( index = 0, p = array ; index + width <= count ; index += width, p += width * size ) {
+			fourSort(p, size, buffer, statistics, compare, context);
+		}
+		
+		switch ( count % 4 ) {
+		case 2:
+			if ( invokeIsLess(p + size, p, statistics, compare, context) ) {
+				swapAt(p, 0, 1, size, buffer, statistics);
+			}
+			break;
+		
+		case 3:
+			threeSort(p, size, buffer, statistics, compare, context);
+			break;
 		}
-		break;
-	
-	case 3:
-		threeSort(p, size, buffer, statistics, compare, context);
-		break;
 	}
 	
 	while ( width < count ) {
@@ -732,8 +935,30 @@ void bottomUpMergeFourSort(void *array, void *buffer, size_t count, size_t size,
 
 //	MARK: - Cole Sort
 
-void coleMergeIntoSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+///	Stable merge of two sorted runs that need not be adjacent
+static void mergeRunsIntoSorted(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t comparisons = networkMergeRuns(lower, lowerCount, upper, upperCount, merged, size, compare);
+	
+	if ( comparisons ) {
+		if ( SORTING_STATISTICS && statistics ) {
+			statistics->accesses += (lowerCount + upperCount) * 2;
+			statistics->writes += lowerCount + upperCount;
+			statistics->assignments += lowerCount + upperCount;
+			statistics->comparisons += comparisons;
+		}
+		
+		return;
+	}
+	
+	gallopMergeRuns(lower, lowerCount, upper, upperCount, merged, size, statistics, compare, context);
+}
+
+static void coleMergeIntoSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -755,10 +980,10 @@ void coleMergeIntoSorted(void const *unmerged, void *merged, size_t count, size_
 			while ( m <= n ) {
 				o = (m + n) / 2;
 				
-				if ( invokeIsLess(unmerged + i * size, unmerged + o * size, statistics, compare, context) ) {
-					n = o - 1;
-				} else {
+				if ( invokeIsLess(unmerged + o * size, unmerged + i * size, statistics, compare, context) ) {
 					m = o + 1;
+				} else {
+					n = o - 1;
 				}
 			}
 			
@@ -799,35 +1024,14 @@ void coleMergeIntoSorted(void const *unmerged, void *merged, size_t count, size_
 		return;
 	}
 	
-	const void *u = unmerged, *v = unmerged + split * size;
-	void *w = merged;
-	
-	for ( i = 0, j = split ;; ) {
-		if ( invokeIsLess(v, u, statistics, compare, context) ) {
-			j += 1;
-			assignAt(w, 0, size, v, statistics);
-			v += size;
-			w += size;
-			
-			if ( !(j < count) ) {
-				assignManyAt(w, 0, split - i, size, u, statistics);
-				break;
-			}
-		} else {
-			i += 1;
-			assignAt(w, 0, size, u, statistics);
-			u += size;
-			w += size;
-			
-			if ( !(i < split) ) {
-				assignManyAt(w, 0, count - j, size, v, statistics);
-				break;
-			}
-		}
+	if ( networkMergeCounted(unmerged, merged, count, split, size, statistics, compare) ) {
+		return;
 	}
+	
+	gallopMergeRuns(unmerged, split, unmerged + split * size, count - split, merged, size, statistics, compare, context);
 }
 
-void coleMergeSorted(void *array, size_t runs[4], size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
+static void coleMergeSorted(void *array, size_t runs[4], size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
 	size_t a = 0, b = runs[0], c = runs[1] + b, d = runs[2] + c, e = runs[3] + d;
 	
 	if ( b == e ) {
@@ -855,68 +1059,154 @@ void coleMergeSorted(void *array, size_t runs[4], size_t size, void *buffer, str
 	coleMergeIntoSorted(buffer, array, e, c, size, statistics, compare, context);
 }
 
-size_t coleSeek(void *array, void *buffer, size_t count, size_t size, size_t minimum, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
-		statistics->invocations += 1;
+///	Merge two adjacent sorted runs in place, buffering only the shorter of the parts that are out of place
+static void coleMergeHalf(void *array, size_t count, size_t split, size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( split == 0 || split == count || !invokeIsLess(array + split * size, array + (split - 1) * size, statistics, compare, context) ) {
+		return;
 	}
 	
-	if ( count < 2 ) {
-		return count;
+	size_t start, end, m, n, o;
+	
+	//	lower elements not greater than the first upper element are already in place
+	for ( m = 0, n = split - 1 ; m < n ; ) {
+		o = (m + n) / 2;
+		
+		if ( invokeIsLess(array + split * size, array + o * size, statistics, compare, context) ) {
+			n = o;
+		} else {
+			m = o + 1;
+		}
 	}
 	
-	size_t minimumRun = 8;
-	size_t runs[4] = {};
-	size_t run = 0, sum = 0, seek, limit, equals;
-	unsigned i, isReversed;
+	start = m;
+	
+	//	upper elements not less than the last lower element are already in place
+	for ( m = split + 1, n = count ; m < n ; ) {
+		o = (m + n) / 2;
+		
+		if ( invokeIsLess(array + o * size, array + (split - 1) * size, statistics, compare, context) ) {
+			m = o + 1;
+		} else {
+			n = o;
+		}
+	}
+	
+	end = m;
+	
+	if ( split - start <= end - split ) {
+		assignManyAt(buffer, 0, split - start, size, array + start * size, statistics);
+		mergeRunsIntoSorted(buffer, split - start, array + split * size, end - split, array + start * size, size, statistics, compare, context);
+	} else {
+		assignManyAt(buffer, 0, end - split, size, array + split * size, statistics);
+		mergeRunsBackward(array + start * size, split - start, buffer, end - split, array + start * size, size, statistics, compare, context);
+	}
+}
+
+///	Four way merge with a buffer of space elements, at least half of the whole array
+static void coleMergeHalfSorted(void *array, size_t runs[4], size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t b = runs[0], c = runs[1] + b, d = runs[2] + c, e = runs[3] + d;
+	size_t lower = b < c - b ? b : c - b;
+	
+	if ( b == e ) {
+		return;
+	}
+	
+	if ( c < e && e - c + lower <= space ) {
+		//	ping the upper pair into the buffer, merge the lower pair in place with the rest of the buffer, then pong both back
+		if ( d == e || !invokeIsLess(array + d * size, array + (d - 1) * size, statistics, compare, context) ) {
+			assignManyAt(buffer, 0, e - c, size, array + c * size, statistics);
+		} else if ( invokeIsLess(array + (e - 1) * size, array + c * size, statistics, compare, context) ) {
+			assignManyAt(buffer, 0, e - d, size, array + d * size, statistics);
+			assignManyAt(buffer, e - d, d - c, size, array + c * size, statistics);
+		} else {
+			coleMergeIntoSorted(array + c * size, buffer, e - c, d - c, size, statistics, compare, context);
+		}
+		
+		coleMergeHalf(array, c, b, size, buffer + (e - c) * size, statistics, compare, context);
+		
+		if ( !invokeIsLess(buffer, array + (c - 1) * size, statistics, compare, context) ) {
+			assignManyAt(array, c, e - c, size, buffer, statistics);
+		} else {
+			mergeRunsBackward(array, c, buffer, e - c, array, size, statistics, compare, context);
+		}
+	} else {
+		coleMergeHalf(array, c, b, size, buffer, statistics, compare, context);
+		coleMergeHalf(array + c * size, e - c, d - c, size, buffer, statistics, compare, context);
+		coleMergeHalf(array, e, c, size, buffer, statistics, compare, context);
+	}
+}
+
+///	Length of the ascending or descending run at the start of at least two elements, descending runs are reversed in place
+static size_t coleNaturalRun(void *array, size_t count, size_t size, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t run = 2, equals;
+	unsigned isReversed = invokeIsLess(array + size, array, statistics, compare, context);
+	void *p = array + 2 * size;
 	signed c;
-	void *p;
 	
-	for ( i = 0 ; i < 4 && run + 1 < count ; ++i ) {
-		p = array + run * size;
-		isReversed = invokeIsLess(p + size, p, statistics, compare, context);
-		p += 2 * size;
-		run += 2;
+	if ( isReversed ) {
+		equals = 0;
 		
-		if ( isReversed ) {
-			equals = 0;
+		while ( 1 ) {
+			if ( run < count ) {
+				c = invokeCompare(p, p - size, statistics, compare, context);
+			} else {
+				c = 1;
+			}
 			
-			while ( 1 ) {
-				if ( run < count ) {
-					c = invokeCompare(p, p - size, statistics, compare, context);
-				} else {
-					c = 1;
-				}
-				
-				if ( c == 0 ) {
-					equals += 1;
-				} else if ( equals > 0 ) {
-					//	preserve stability of equal elements within descending runs
-					reverse(array + (run - equals - 1) * size, equals + 1, size, buffer, statistics);
-					equals = 0;
-				}
-				
-				if ( c > 0 ) {
-					break;
-				}
-				
-				p += size;
-				run += 1;
+			if ( c == 0 ) {
+				equals += 1;
+			} else if ( equals > 0 ) {
+				//	preserve stability of equal elements within descending runs
+				reverse(array + (run - equals - 1) * size, equals + 1, size, buffer, statistics);
+				equals = 0;
 			}
-		} else {
-			while ( run < count && 0 == invokeIsLess(p, p - size, statistics, compare, context) ) {
-				p += size;
-				run += 1;
+			
+			if ( c > 0 ) {
+				break;
 			}
+			
+			p += size;
+			run += 1;
 		}
 		
-		if ( isReversed ) {
-			reverse(array + sum * size, run - sum, size, buffer, statistics);
+		reverse(array, run, size, buffer, statistics);
+	} else {
+		while ( run < count && 0 == invokeIsLess(p, p - size, statistics, compare, context) ) {
+			p += size;
+			run += 1;
 		}
+	}
+	
+	return run;
+}
+
+static size_t coleSeek(void *array, void *buffer, size_t count, size_t size, size_t minimum, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	if ( count < 2 ) {
+		return count;
+	}
+	
+	//	equal primitive keys are indistinguishable, so the unstable network is safe for short runs
+	size_t network = networkSortWidth(size, compare);
+	size_t minimumRun = network ? network : 8;
+	size_t runs[4] = {};
+	size_t run = 0, sum = 0, seek, limit;
+	unsigned i;
+	
+	for ( i = 0 ; i < 4 && run + 1 < count ; ++i ) {
+		run = sum + coleNaturalRun(array + sum * size, count - sum, size, buffer, statistics, compare, context);
 		
 		if ( run < sum + minimumRun && run + 1 < minimum ) {
 			limit = count < sum + minimumRun ? count - sum : minimumRun;
 			
-			binaryInsertionSort(array + sum * size, limit, size, run - sum, buffer, statistics, compare, context);
+			if ( network ) {
+				networkSortCounted(array + sum * size, array + sum * size, limit, size, statistics, compare);
+			} else {
+				binaryInsertionSort(array + sum * size, limit, size, run - sum, buffer, statistics, compare, context);
+			}
 			
 			run = sum + limit;
 		}
@@ -940,9 +1230,13 @@ size_t coleSeek(void *array, void *buffer, size_t count, size_t size, size_t min
 		sum = run;
 	}
 	
-	coleMergeSorted(array, runs, size, buffer, statistics, compare, context);
-	
-	while ( run < minimum ) {
+	if ( space ) {
+		coleMergeHalfSorted(array, runs, size, buffer, space, statistics, compare, context);
+	} else {
+		coleMergeSorted(array, runs, size, buffer, statistics, compare, context);
+	}
+	
+	while ( run < minimum ) {
 		runs[0] = run;
 		runs[2] = 0;
 		runs[3] = 0;
@@ -952,7 +1246,7 @@ size_t coleSeek(void *array, void *buffer, size_t count, size_t size, size_t min
 			limit = count - sum;
 			seek = limit < seek ? limit : seek;
 			
-			run = coleSeek(array + sum * size, buffer, limit, size, seek, statistics, compare, context);
+			run = coleSeek(array + sum * size, buffer, limit, size, seek, space, statistics, compare, context);
 			sum += run;
 			runs[i] = run;
 		}
@@ -964,13 +1258,117 @@ size_t coleSeek(void *array, void *buffer, size_t count, size_t size, size_t min
 			i = 4;
 		}
 		
-		coleMergeSorted(array, runs, size, buffer, statistics, compare, context);
+		if ( space ) {
+			coleMergeHalfSorted(array, runs, size, buffer, space, statistics, compare, context);
+		} else {
+			coleMergeSorted(array, runs, size, buffer, statistics, compare, context);
+		}
+		
 		run = sum;
 	}
 	
 	return sum;
 }
 
+//	at most three runs of each power wait on the stack, and powers stay within 34 for any 64 bit count
+#define kPowerMaximumRuns (3 * 34)
+
+///	Base four node power of the boundary between two adjacent runs, the first base four digit where the midpoints of the runs differ
+static unsigned powerColeNode(size_t begin, size_t split, size_t end, size_t count) {
+	size_t a = begin + split, b = split + end, n = count * 2, m, o;
+	unsigned power = 0;
+	
+	//	midpoints are a / n and b / n, compare them one base four digit at a time
+	while ( 1 ) {
+		power += 1;
+		a *= 4;
+		b *= 4;
+		m = a / n;
+		o = b / n;
+		
+		if ( m != o ) {
+			return power;
+		}
+		
+		a -= m * n;
+		b -= o * n;
+	}
+}
+
+static size_t powerColeRun(void *array, size_t count, size_t size, size_t minimumRun, void *buffer, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t run = count < 2 ? count : coleNaturalRun(array, count, size, buffer, statistics, compare, context);
+	size_t limit = count < minimumRun ? count : minimumRun;
+	
+	if ( run < limit ) {
+		if ( networkSortWidth(size, compare) ) {
+			networkSortCounted(array, array, limit, size, statistics, compare);
+		} else {
+			binaryInsertionSort(array, limit, size, run, buffer, statistics, compare, context);
+		}
+		
+		run = limit;
+	}
+	
+	return run;
+}
+
+static void powerColeSeek(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t network = networkSortWidth(size, compare);
+	size_t minimumRun = network ? network : 8;
+	size_t starts[kPowerMaximumRuns];
+	unsigned powers[kPowerMaximumRuns];
+	size_t runs[4];
+	size_t begin = 0, split, end = 0;
+	unsigned depth = 0, power, top, i, j;
+	
+	split = powerColeRun(array, count, size, minimumRun, buffer, statistics, compare, context);
+	
+	while ( 1 ) {
+		power = 0;
+		
+		if ( split < count ) {
+			end = split + powerColeRun(array + split * size, count - split, size, minimumRun, buffer, statistics, compare, context);
+			power = powerColeNode(begin, split, end, count);
+		}
+		
+		//	runs of equal power on top of the stack are siblings in the merge tree, merge them with the current run at once
+		while ( depth > 0 && powers[depth - 1] > power ) {
+			top = powers[depth - 1];
+			
+			for ( i = 0 ; i < 3 && depth > 0 && powers[depth - 1] == top ; ++i ) {
+				depth -= 1;
+			}
+			
+			for ( j = 0 ; j < i ; ++j ) {
+				runs[j] = (j + 1 < i ? starts[depth + j + 1] : begin) - starts[depth + j];
+			}
+			
+			runs[i] = split - begin;
+			
+			for ( j = i + 1 ; j < 4 ; ++j ) {
+				runs[j] = 0;
+			}
+			
+			begin = starts[depth];
+			coleMergeSorted(array + begin * size, runs, size, buffer, statistics, compare, context);
+		}
+		
+		if ( !power ) {
+			break;
+		}
+		
+		starts[depth] = begin;
+		powers[depth] = power;
+		depth += 1;
+		begin = split;
+		split = end;
+	}
+}
+
 ///	Merge sort that operates on four runs at a time, starting with natural ascending or descending runs
 void coleSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
 	if ( count < 8 ) {
@@ -978,19 +1376,284 @@ void coleSort(void *array, void *buffer, size_t count, size_t size, struct Sorti
 		return;
 	}
 	
-	coleSeek(array, buffer, count, size, count, statistics, compare, context);
+	//	constant element sizes let the compiler specialize the data motion of the whole sort
+	switch ( size ) {
+	case 4: coleSeek(array, buffer, count, 4, count, 0, statistics, compare, context); break;
+	case 8: coleSeek(array, buffer, count, 8, count, 0, statistics, compare, context); break;
+	case 16: coleSeek(array, buffer, count, 16, count, 0, statistics, compare, context); break;
+	default: coleSeek(array, buffer, count, size, count, 0, statistics, compare, context); break;
+	}
+}
+
+///	Cole sort with a buffer of only (count + 1) / 2 elements, the four way merges buffer half of their runs and merge the rest in place
+void halfColeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( count < 8 ) {
+		binaryInsertionSort(array, count, size, 1, buffer, statistics, compare, context);
+		return;
+	}
+	
+	size_t space = (count + 1) / 2;
+	
+	switch ( size ) {
+	case 4: coleSeek(array, buffer, count, 4, count, space, statistics, compare, context); break;
+	case 8: coleSeek(array, buffer, count, 8, count, space, statistics, compare, context); break;
+	case 16: coleSeek(array, buffer, count, 16, count, space, statistics, compare, context); break;
+	default: coleSeek(array, buffer, count, size, count, space, statistics, compare, context); break;
+	}
+}
+
+///	Sort elements appended to an array whose first sorted elements are already in order, only the appended elements are sorted before merging them into the prefix
+void coleSortAppended(void *array, void *buffer, size_t count, size_t size, size_t sorted, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( !(sorted < count) ) {
+		return;
+	}
+	
+	coleSort(array + sorted * size, buffer, count - sorted, size, statistics, compare, context);
+	
+	//	only the prefix elements greater than the least appended element move, and the buffer holds whichever side of them is shorter
+	coleMergeHalf(array, count, sorted, size, buffer, statistics, compare, context);
+}
+
+///	Merge sort that finds natural runs like cole sort, then merges them in the order of four way powersort, up to four runs at a time
+void powerColeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( count < 8 ) {
+		binaryInsertionSort(array, count, size, 1, buffer, statistics, compare, context);
+		return;
+	}
+	
+	switch ( size ) {
+	case 4: powerColeSeek(array, buffer, count, 4, statistics, compare, context); break;
+	case 8: powerColeSeek(array, buffer, count, 8, statistics, compare, context); break;
+	case 16: powerColeSeek(array, buffer, count, 16, statistics, compare, context); break;
+	default: powerColeSeek(array, buffer, count, size, statistics, compare, context); break;
+	}
+}
+
+//	MARK: - Parallel Merge
+
+#define kParallelMaximumThreads 64
+#define kParallelMaximumTasks (kParallelMaximumThreads * 2)
+#define kParallelMinimumChunk 4096
+
+enum ParallelTaskKind {
+	kParallelTaskSort,
+	kParallelTaskMerge
+};
+
+struct ParallelTask {
+	enum ParallelTaskKind kind;
+	void const *lower;
+	void const *upper;
+	void *merged;	//	sorted in place by kParallelTaskSort
+	void *buffer;
+	size_t lowerCount;
+	size_t upperCount;
+	size_t size;
+	struct SortingStatistics statistics;
+	struct SortingStatistics *counting;
+	Compare *compare;
+	void *context;
+};
+
+///	Co-rank of output index k, the count of lower elements among the first k merged elements, with lower elements first among equals
+static size_t mergeCoRank(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, size_t k, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t i, m = k > upperCount ? k - upperCount : 0, n = k < lowerCount ? k : lowerCount;
+	
+	while ( m < n ) {
+		i = (m + n) / 2;
+		
+		if ( !invokeIsLess(upper + (k - i - 1) * size, lower + i * size, statistics, compare, context) ) {
+			m = i + 1;
+		} else {
+			n = i;
+		}
+	}
+	
+	return m;
+}
+
+///	Divide one merge into slices of equal output, appending a task for each slice
+static unsigned mergePathTasks(struct ParallelTask tasks[], unsigned taskCount, void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, unsigned slices, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t count = lowerCount + upperCount, k, i, previousK = 0, previousI = 0;
+	unsigned slice;
+	
+	slices = slices < 1 ? 1 : slices;
+	slices = slices < kParallelMaximumTasks - taskCount ? slices : kParallelMaximumTasks - taskCount;
+	
+	for ( slice = 1 ; slice <= slices ; ++slice ) {
+		k = count * slice / slices;
+		i = slice < slices ? mergeCoRank(lower, lowerCount, upper, upperCount, k, size, statistics, compare, context) : lowerCount;
+		
+		struct ParallelTask *task = &tasks[taskCount++];
+		
+		memset(task, 0, sizeof(*task));
+		task->kind = kParallelTaskMerge;
+		task->lower = lower + previousI * size;
+		task->lowerCount = i - previousI;
+		task->upper = upper + (previousK - previousI) * size;
+		task->upperCount = (k - i) - (previousK - previousI);
+		task->merged = merged + previousK * size;
+		
+		previousK = k;
+		previousI = i;
+	}
+	
+	return taskCount;
+}
+
+static void *parallelTask(void *argument) {
+	struct ParallelTask *task = argument;
+	
+	switch ( task->kind ) {
+	case kParallelTaskSort:
+		coleSort(task->merged, task->buffer, task->lowerCount, task->size, task->counting, task->compare, task->context);
+		break;
+	
+	case kParallelTaskMerge:
+		mergeRunsIntoSorted(task->lower, task->lowerCount, task->upper, task->upperCount, task->merged, task->size, task->counting, task->compare, task->context);
+		break;
+	}
+	
+	return NULL;
+}
+
+///	Perform each task on its own thread, then add the statistics of each thread to the total
+static void parallelPerform(struct ParallelTask tasks[], unsigned count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	pthread_t threads[kParallelMaximumTasks];
+	unsigned created[kParallelMaximumTasks];
+	unsigned i;
+	
+	for ( i = 0 ; i < count ; ++i ) {
+		tasks[i].size = size;
+		tasks[i].counting = SORTING_STATISTICS && statistics ? &tasks[i].statistics : NULL;
+		tasks[i].compare = compare;
+		tasks[i].context = context;
+	}
+	
+	for ( i = 1 ; i < count ; ++i ) {
+		created[i] = 0 == pthread_create(&threads[i], NULL, parallelTask, &tasks[i]);
+	}
+	
+	parallelTask(&tasks[0]);
+	
+	for ( i = 1 ; i < count ; ++i ) {
+		if ( created[i] ) {
+			pthread_join(threads[i], NULL);
+		} else {
+			parallelTask(&tasks[i]);
+		}
+	}
+	
+	if ( SORTING_STATISTICS && statistics ) {
+		for ( i = 0 ; i < count ; ++i ) {
+			statistics->invocations += tasks[i].statistics.invocations;
+			statistics->accesses += tasks[i].statistics.accesses;
+			statistics->assignments += tasks[i].statistics.assignments;
+			statistics->writes += tasks[i].statistics.writes;
+			statistics->comparisons += tasks[i].statistics.comparisons;
+		}
+	}
+}
+
+///	Stable merge of two adjacent sorted runs, divided by merge path into slices of equal output that merge on separate threads
+void parallelMergeSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	struct ParallelTask tasks[kParallelMaximumTasks];
+	unsigned slices = count / kParallelMinimumChunk < threads ? (unsigned)(count / kParallelMinimumChunk) : threads;
+	unsigned taskCount = mergePathTasks(tasks, 0, unmerged, split, unmerged + split * size, count - split, merged, slices, size, statistics, compare, context);
+	
+	parallelPerform(tasks, taskCount, size, statistics, compare, context);
+}
+
+//	MARK: - Parallel Cole Sort
+
+///	Cole sort that sorts chunks split at natural run boundaries on separate threads, then merges the chunks four ways by merge path
+void parallelColeSort(void *array, void *buffer, size_t count, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	threads = threads < kParallelMaximumThreads ? threads : kParallelMaximumThreads;
+	threads = count / kParallelMinimumChunk < threads ? (unsigned)(count / kParallelMinimumChunk) : threads;
+	
+	if ( threads < 2 ) {
+		coleSort(array, buffer, count, size, statistics, compare, context);
+		return;
+	}
+	
+	struct ParallelTask tasks[kParallelMaximumTasks];
+	size_t bounds[kParallelMaximumThreads + 1];
+	size_t chunk = count / threads, index, limit, lower, upper;
+	unsigned i, runCount = threads, taskCount;
+	void *unmerged = array, *merged = buffer, *swap;
+	
+	//	move each boundary forward to the end of an ascending run so sorted regions merge without comparisons
+	bounds[0] = 0;
+	bounds[threads] = count;
+	
+	for ( i = 1 ; i < threads ; ++i ) {
+		index = chunk * i;
+		index = index > bounds[i - 1] ? index : bounds[i - 1] + 1;
+		limit = index + chunk / 4;
+		
+		while ( index < limit && !invokeIsLess(array + index * size, array + (index - 1) * size, statistics, compare, context) ) {
+			index += 1;
+		}
+		
+		bounds[i] = index;
+	}
+	
+	for ( i = 0 ; i < runCount ; ++i ) {
+		memset(&tasks[i], 0, sizeof(tasks[i]));
+		tasks[i].kind = kParallelTaskSort;
+		tasks[i].merged = array + bounds[i] * size;
+		tasks[i].buffer = buffer + bounds[i] * size;
+		tasks[i].lowerCount = bounds[i + 1] - bounds[i];
+	}
+	
+	parallelPerform(tasks, runCount, size, statistics, compare, context);
+	
+	//	each pass merges pairs of runs between the array and the buffer, so two passes form the four way merge of coleMergeSorted
+	while ( runCount > 1 ) {
+		for ( taskCount = 0, i = 0 ; i < runCount ; i += 2 ) {
+			lower = bounds[i + 1] - bounds[i];
+			upper = i + 1 < runCount ? bounds[i + 2] - bounds[i + 1] : 0;
+			
+			taskCount = mergePathTasks(tasks, taskCount, unmerged + bounds[i] * size, lower, unmerged + (bounds[i] + lower) * size, upper, merged + bounds[i] * size, (unsigned)(((lower + upper) * threads + count - 1) / count), size, statistics, compare, context);
+			
+			bounds[i / 2] = bounds[i];
+		}
+		
+		runCount = (runCount + 1) / 2;
+		bounds[runCount] = count;
+		
+		parallelPerform(tasks, taskCount, size, statistics, compare, context);
+		
+		swap = unmerged;
+		unmerged = merged;
+		merged = swap;
+	}
+	
+	if ( unmerged != array ) {
+		taskCount = mergePathTasks(tasks, 0, buffer, count, buffer + count * size, 0, array, threads, size, statistics, compare, context);
+		
+		parallelPerform(tasks, taskCount, size, statistics, compare, context);
+	}
 }
 
 //	MARK: - Tumble Marge Sort
 
 #define kTumbleMaximumRuns 32
 
-size_t tumbleMergeIntoSorted(void const *unmerged, void *merged, size_t runs[], unsigned runCount, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static size_t tumbleMergeIntoSorted(void const *unmerged, void *merged, size_t runs[], unsigned runCount, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
-	size_t index, total = 0;
+	size_t index, total = 0, run, streak = 0, minimum = kGallopMinimum;
 	struct PointerCount pointers[kTumbleMaximumRuns];
 	struct PointerCount temporary[1];
 	unsigned i, m, n, o, valid = runCount;
@@ -1021,13 +1684,26 @@ size_t tumbleMergeIntoSorted(void const *unmerged, void *merged, size_t runs[],
 		}
 	}
 	
-	for ( index = 0 ; index < total ; ++index ) {
-		assignAt(merged, index, size, pointers[0].p, statistics);
+	for ( index = 0 ; index < total ; index += run ) {
+		if ( streak < minimum || valid < 2 ) {
+			run = 1;
+			assignAt(merged, index, size, pointers[0].p, statistics);
+		} else {
+			//	gallop through the leading run up to the head of the next run, equal elements stay in run order
+			run = gallopCount(pointers[1].p, pointers[0].p, pointers[0].n, size, pointers[0].p < pointers[1].p, statistics, compare, context);
+			assignManyAt(merged, index, run, size, pointers[0].p, statistics);
+			
+			if ( run < kGallopMinimum ) {
+				minimum += 1;
+			} else {
+				minimum -= minimum > 1;
+			}
+		}
 		
-		pointers[0].n -= 1;
+		pointers[0].n -= run;
 		
 		if ( pointers[0].n > 0 ) {
-			pointers[0].p += size;
+			pointers[0].p += run * size;
 			
 			m = 1;
 			n = valid - 1;
@@ -1044,9 +1720,13 @@ size_t tumbleMergeIntoSorted(void const *unmerged, void *merged, size_t runs[],
 			
 			if ( m > 1 ) {
 				slideUp(pointers, 0, m - 1, sizeof(struct PointerCount), temporary, NULL);
+				streak = 0;
+			} else {
+				streak += 1;
 			}
 		} else {
 			valid -= 1;
+			streak = 0;
 			
 			slideUp(pointers, 0, valid, sizeof(struct PointerCount), temporary, NULL);
 		}
@@ -1055,7 +1735,7 @@ size_t tumbleMergeIntoSorted(void const *unmerged, void *merged, size_t runs[],
 	return total;
 }
 
-unsigned tumbleMergeSorted(void *unmerged, size_t runs[], unsigned count, size_t size, void *merged, struct SortingStatistics *statistics, Compare compare, void *context) {
+static unsigned tumbleMergeSorted(void *unmerged, size_t runs[], unsigned count, size_t size, void *merged, struct SortingStatistics *statistics, Compare compare, void *context) {
 	if ( count > 2 ) {
 		tumbleMergeIntoSorted(unmerged, merged, runs, count, size, statistics, compare, context);
 	} else if ( count > 1 ) {
@@ -1067,8 +1747,8 @@ unsigned tumbleMergeSorted(void *unmerged, size_t runs[], unsigned count, size_t
 	return 1;
 }
 
-size_t tumbleMergeSeek(void *array, void *buffer, size_t count, size_t size, size_t minimum, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static size_t tumbleMergeSeek(void *array, void *buffer, size_t count, size_t size, size_t minimum, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -1157,8 +1837,8 @@ void tumbleMergeSort(void *array, void *buffer, size_t count, size_t size, struc
 
 #define kPolymergeMaximumRuns 32
 
-void polymergeFourSort(void *unsorted, void *sorted, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void polymergeFourSort(void *unsorted, void *sorted, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 		statistics->accesses += 4;
 	}
@@ -1173,7 +1853,7 @@ void polymergeFourSort(void *unsorted, void *sorted, size_t size, struct Sorting
 	unsigned t;
 	
 	if ( !invokeIsLess(unsorted + _2 * size, unsorted + _1 * size, statistics, compare, context) ) {
-		
+	
 	} else if ( invokeIsLess(unsorted + _3 * size, unsorted + _0 * size, statistics, compare, context) ) {
 		t = _0; _0 = _2; _2 = t;
 		t = _1; _1 = _3; _3 = t;
@@ -1195,8 +1875,8 @@ void polymergeFourSort(void *unsorted, void *sorted, size_t size, struct Sorting
 	assignAt(sorted, 3, size, unsorted + _3 * size, statistics);
 }
 
-void polymergeSorted(void const *unmerged, void *merged, size_t count, size_t width, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void polymergeSorted(void const *unmerged, void *merged, size_t count, size_t width, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -1263,12 +1943,27 @@ void polymergeSorted(void const *unmerged, void *merged, size_t count, size_t wi
 	}
 }
 
-void polymergeJuggle(void *array, void *buffer, size_t count, size_t size, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+static void polymergeJuggle(void *array, void *buffer, size_t count, size_t size, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
-	if ( count <= kPolymergeMaximumRuns * 4 ) {
+	size_t network = networkSortWidth(size, compare);
+	
+	if ( network && count <= kPolymergeMaximumRuns * network ) {
+		size_t index, limit, width = network;
+		void *sorted = !juggling != (width < count) ? array : buffer;
+		
+		for ( index = 0 ; index < count ; index += width ) {
+			limit = count - index < width ? count - index : width;
+			
+			networkSortCounted(array + index * size, sorted + index * size, limit, size, statistics, compare);
+		}
+		
+		if ( width < count ) {
+			polymergeSorted(sorted, sorted == array ? buffer : array, count, width, size, statistics, compare, context);
+		}
+	} else if ( count <= kPolymergeMaximumRuns * 4 ) {
 		size_t index, width = 4;
 		
 		if ( !juggling != (width < count) ) {
@@ -1316,8 +2011,13 @@ void polymergeJuggle(void *array, void *buffer, size_t count, size_t size, unsig
 void polymergeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context) {
 	if ( count < 2 ) {
 		return;
-	} else {
-		polymergeJuggle(array, buffer, count, size, 0, statistics, compare, context);
+	}
+	
+	switch ( size ) {
+	case 4: polymergeJuggle(array, buffer, count, 4, 0, statistics, compare, context); break;
+	case 8: polymergeJuggle(array, buffer, count, 8, 0, statistics, compare, context); break;
+	case 16: polymergeJuggle(array, buffer, count, 16, 0, statistics, compare, context); break;
+	default: polymergeJuggle(array, buffer, count, size, 0, statistics, compare, context); break;
 	}
 }
 
@@ -1379,7 +2079,7 @@ void bottomUpPolymergeSort(void *array, void *buffer, size_t count, size_t size,
 //	MARK: - Juggle Merge Sort
 
 void juggleMergeSort(void *array, void *buffer, size_t count, size_t size, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
+	if ( SORTING_STATISTICS && statistics ) {
 		statistics->invocations += 1;
 	}
 	
@@ -1406,150 +2106,2541 @@ void juggleMergeSort(void *array, void *buffer, size_t count, size_t size, unsig
 	}
 }
 
-//	MARK: - Heap Sort
+//	MARK: - Block Merge Sort
 
-void heapSift(void *array, size_t start, size_t end, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
-		statistics->invocations += 1;
-	}
+#define kBlockMinimumLevel 16
+
+struct BlockRange {
+	size_t start;
+	size_t end;
+};
+
+///	Splits count elements into a power of two number of nearly equal ranges, then doubles the range length at each level
+struct BlockIterator {
+	size_t count;
+	size_t denominator;
+	size_t numerator;
+	size_t decimal;
+	size_t numeratorStep;
+	size_t decimalStep;
+};
+
+///	Scratch space for the block merge, temporary holds one element for swaps or is null without a buffer and cache holds up to cacheCount elements
+struct BlockMerge {
+	void *array;
+	size_t size;
+	void *temporary;
+	void *cache;
+	size_t cacheCount;
+	struct SortingStatistics *statistics;
+	Compare *compare;
+	void *context;
+};
+
+static inline struct BlockRange blockRange(size_t start, size_t end) {
+	struct BlockRange range = {start, end};
 	
-	size_t i = start, j = start;
-	size_t a, b;
-	unsigned d = 0;
+	return range;
+}
+
+static inline size_t blockLength(struct BlockRange range) {
+	return range.end - range.start;
+}
+
+static void blockIteratorBegin(struct BlockIterator *iterator) {
+	iterator->numerator = 0;
+	iterator->decimal = 0;
+}
+
+static struct BlockIterator blockIterator(size_t count, size_t minimumLevel) {
+	struct BlockIterator iterator;
+	size_t powerOfTwo = 1;
 	
-	while ( j * 2 + 2 <= end ) {
-		if ( invokeIsLess(array + (j * 2 + 1) * size, array + (j * 2 + 2) * size, statistics, compare, context) ) {
-			j = j * 2 + 2;
-		} else {
-			j = j * 2 + 1;
-		}
-		d += 1;
+	while ( powerOfTwo <= count / 2 ) {
+		powerOfTwo *= 2;
 	}
 	
-	while ( j * 2 + 1 <= end ) {
-		j = j * 2 + 1;
-		d += 1;
-	}
+	iterator.count = count;
+	iterator.denominator = powerOfTwo / minimumLevel;
+	iterator.numeratorStep = count % iterator.denominator;
+	iterator.decimalStep = count / iterator.denominator;
+	blockIteratorBegin(&iterator);
 	
-	while ( invokeIsLess(array + j * size, array + i * size, statistics, compare, context) ) {
-		j = (j - 1) / 2;
-		d -= 1;
+	return iterator;
+}
+
+static struct BlockRange blockIteratorNext(struct BlockIterator *iterator) {
+	size_t start = iterator->decimal;
+	
+	iterator->decimal += iterator->decimalStep;
+	iterator->numerator += iterator->numeratorStep;
+	
+	if ( iterator->numerator >= iterator->denominator ) {
+		iterator->numerator -= iterator->denominator;
+		iterator->decimal += 1;
 	}
 	
-	if ( d > 0 ) {
-		accessAt(array, i, size, temporary, statistics);
-		
-		while ( d --> 0 ) {
-			a = (j + 1 - (1 << d)) >> d;
-			b = (a - 1) >> 1;
-			assignAt(array, b, size, array + a * size, statistics);
-		}
-		
-		assignAt(array, j, size, temporary, statistics);
+	return blockRange(start, iterator->decimal);
+}
+
+static inline unsigned blockIteratorFinished(struct BlockIterator const *iterator) {
+	return iterator->decimal >= iterator->count;
+}
+
+static unsigned blockIteratorNextLevel(struct BlockIterator *iterator) {
+	iterator->decimalStep += iterator->decimalStep;
+	iterator->numeratorStep += iterator->numeratorStep;
+	
+	if ( iterator->numeratorStep >= iterator->denominator ) {
+		iterator->numeratorStep -= iterator->denominator;
+		iterator->decimalStep += 1;
 	}
+	
+	return iterator->decimalStep < iterator->count;
 }
 
-///	Heap Sort organizes elements into a heap then extracts elements from the heap in sorted order
-void heapSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( count < 2 ) {
+static inline unsigned blockIsLess(struct BlockMerge const *merge, size_t a, size_t b) {
+	return invokeIsLess(merge->array + a * merge->size, merge->array + b * merge->size, merge->statistics, merge->compare, merge->context);
+}
+
+///	Swap through the temporary element, or byte by byte when there is no buffer at all
+static inline void blockSwap(struct BlockMerge const *merge, size_t a, size_t b) {
+	if ( merge->temporary ) {
+		swapAt(merge->array, a, b, merge->size, merge->temporary, merge->statistics);
 		return;
 	}
 	
-	size_t start = count / 2;
+	unsigned char *p = merge->array + a * merge->size, *q = merge->array + b * merge->size, t;
 	
-	while ( start > 0 ) {
-		start -= 1;
-		
-		heapSift(array, start, count - 1, size, temporary, statistics, compare, context);
+	if ( SORTING_STATISTICS && merge->statistics ) {
+		merge->statistics->accesses += 2;
+		merge->statistics->writes += 2;
+		merge->statistics->assignments += 2;
 	}
 	
-	size_t end = count - 1;
-	
-	while ( end > 0 ) {
-		swapAt(array, 0, end, size, temporary, statistics);
-		
-		end -= 1;
-		
-		heapSift(array, 0, end, size, temporary, statistics, compare, context);
+	for ( size_t i = 0 ; i < merge->size ; ++i ) {
+		t = p[i];
+		p[i] = q[i];
+		q[i] = t;
 	}
 }
 
-//	MARK: - Quick Sort
+static void blockSwapMany(struct BlockMerge const *merge, size_t a, size_t b, size_t count) {
+	while ( count-- ) {
+		blockSwap(merge, a++, b++);
+	}
+}
 
-size_t quickPartition(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
-	if ( statistics ) {
-		statistics->invocations += 1;
+static void blockReverse(struct BlockMerge const *merge, struct BlockRange range) {
+	while ( range.start + 1 < range.end ) {
+		blockSwap(merge, range.start++, --range.end);
 	}
+}
+
+///	Rotate a range left by amount, through the cache when the smaller side fits and by three reversals otherwise
+static void blockRotate(struct BlockMerge const *merge, size_t amount, struct BlockRange range, size_t cacheCount) {
+	size_t lower = amount, upper = blockLength(range) - amount, size = merge->size;
+	void *array = merge->array;
+	
+	if ( lower == 0 || upper == 0 ) {
+		return;
+	}
+	
+	if ( lower <= upper && lower <= cacheCount ) {
+		assignManyAt(merge->cache, 0, lower, size, array + range.start * size, merge->statistics);
+		assignManyAt(array, range.start, upper, size, array + (range.start + lower) * size, merge->statistics);
+		assignManyAt(array, range.start + upper, lower, size, merge->cache, merge->statistics);
+	} else if ( upper < lower && upper <= cacheCount ) {
+		assignManyAt(merge->cache, 0, upper, size, array + (range.start + lower) * size, merge->statistics);
+		assignManyAt(array, range.start + upper, lower, size, array + range.start * size, merge->statistics);
+		assignManyAt(array, range.start, upper, size, merge->cache, merge->statistics);
+	} else {
+		blockReverse(merge, blockRange(range.start, range.start + lower));
+		blockReverse(merge, blockRange(range.start + lower, range.end));
+		blockReverse(merge, range);
+	}
+}
+
+///	First index in range whose element is not less than value
+static size_t blockBinaryFirst(struct BlockMerge const *merge, size_t value, struct BlockRange range) {
+	size_t start = range.start, end = range.end, middle;
+	
+	while ( start < end ) {
+		middle = start + (end - start) / 2;
+		
+		if ( blockIsLess(merge, middle, value) ) {
+			start = middle + 1;
+		} else {
+			end = middle;
+		}
+	}
+	
+	return start;
+}
+
+///	First index in range whose element is greater than value
+static size_t blockBinaryLast(struct BlockMerge const *merge, size_t value, struct BlockRange range) {
+	size_t start = range.start, end = range.end, middle;
+	
+	while ( start < end ) {
+		middle = start + (end - start) / 2;
+		
+		if ( !blockIsLess(merge, value, middle) ) {
+			start = middle + 1;
+		} else {
+			end = middle;
+		}
+	}
+	
+	return start;
+}
+
+///	Stable insertion sort of a range, by binaryInsertionSort through the temporary element or by rotating each element into place without one
+static void blockInsertionSort(struct BlockMerge const *merge, struct BlockRange range) {
+	if ( merge->temporary ) {
+		binaryInsertionSort(merge->array + range.start * merge->size, blockLength(range), merge->size, 1, merge->temporary, merge->statistics, merge->compare, merge->context);
+		return;
+	}
+	
+	for ( size_t index = range.start + 1, place ; index < range.end ; ++index ) {
+		place = blockBinaryLast(merge, index, blockRange(range.start, index));
+		blockRotate(merge, index - place, blockRange(place, index + 1), 0);
+	}
+}
+
+//	galloping searches that step through the range expecting about unique distinct values
+
+static size_t blockFindFirstForward(struct BlockMerge const *merge, size_t value, struct BlockRange range, size_t unique) {
+	if ( blockLength(range) == 0 ) {
+		return range.start;
+	}
+	
+	size_t index, skip = blockLength(range) / unique;
+	
+	skip = skip > 1 ? skip : 1;
+	
+	for ( index = range.start + skip ; blockIsLess(merge, index - 1, value) ; index += skip ) {
+		if ( index >= range.end - skip ) {
+			return blockBinaryFirst(merge, value, blockRange(index, range.end));
+		}
+	}
+	
+	return blockBinaryFirst(merge, value, blockRange(index - skip, index));
+}
+
+static size_t blockFindLastForward(struct BlockMerge const *merge, size_t value, struct BlockRange range, size_t unique) {
+	if ( blockLength(range) == 0 ) {
+		return range.start;
+	}
+	
+	size_t index, skip = blockLength(range) / unique;
+	
+	skip = skip > 1 ? skip : 1;
+	
+	for ( index = range.start + skip ; !blockIsLess(merge, value, index - 1) ; index += skip ) {
+		if ( index >= range.end - skip ) {
+			return blockBinaryLast(merge, value, blockRange(index, range.end));
+		}
+	}
+	
+	return blockBinaryLast(merge, value, blockRange(index - skip, index));
+}
+
+static size_t blockFindFirstBackward(struct BlockMerge const *merge, size_t value, struct BlockRange range, size_t unique) {
+	if ( blockLength(range) == 0 ) {
+		return range.start;
+	}
+	
+	size_t index, skip = blockLength(range) / unique;
+	
+	skip = skip > 1 ? skip : 1;
+	
+	for ( index = range.end - skip ; index > range.start && !blockIsLess(merge, index - 1, value) ; index -= skip ) {
+		if ( index < range.start + skip ) {
+			return blockBinaryFirst(merge, value, blockRange(range.start, index));
+		}
+	}
+	
+	return blockBinaryFirst(merge, value, blockRange(index, index + skip));
+}
+
+static size_t blockFindLastBackward(struct BlockMerge const *merge, size_t value, struct BlockRange range, size_t unique) {
+	if ( blockLength(range) == 0 ) {
+		return range.start;
+	}
+	
+	size_t index, skip = blockLength(range) / unique;
+	
+	skip = skip > 1 ? skip : 1;
+	
+	for ( index = range.end - skip ; index > range.start && blockIsLess(merge, value, index - 1) ; index -= skip ) {
+		if ( index < range.start + skip ) {
+			return blockBinaryLast(merge, value, blockRange(range.start, index));
+		}
+	}
+	
+	return blockBinaryLast(merge, value, blockRange(index, index + skip));
+}
+
+///	Merge A, already copied to the cache, with B into the space starting at A
+static void blockMergeExternal(struct BlockMerge const *merge, struct BlockRange a, struct BlockRange b) {
+	size_t i = 0, j = b.start, n = a.start, count = blockLength(a), size = merge->size;
+	void *array = merge->array, *cache = merge->cache;
+	
+	while ( i < count && j < b.end ) {
+		if ( !invokeIsLess(array + j * size, cache + i * size, merge->statistics, merge->compare, merge->context) ) {
+			assignAt(array, n++, size, cache + i++ * size, merge->statistics);
+		} else {
+			assignAt(array, n++, size, array + j++ * size, merge->statistics);
+		}
+	}
+	
+	assignManyAt(array, n, count - i, size, cache + i * size, merge->statistics);
+}
+
+///	Merge A, already swapped into the internal buffer, with B by swapping, leaving the buffer contents reordered after B
+static void blockMergeInternal(struct BlockMerge const *merge, struct BlockRange a, struct BlockRange b, struct BlockRange buffer) {
+	size_t i = 0, j = 0, n = 0, count = blockLength(a);
+	
+	while ( i < count && j < blockLength(b) ) {
+		if ( !blockIsLess(merge, b.start + j, buffer.start + i) ) {
+			blockSwap(merge, a.start + n++, buffer.start + i++);
+		} else {
+			blockSwap(merge, a.start + n++, b.start + j++);
+		}
+	}
+	
+	blockSwapMany(merge, buffer.start + i, a.start + n, count - i);
+}
+
+///	Merge by binary searching B for the first element of A and rotating A into place, efficient when there are few distinct values
+static void blockMergeInPlace(struct BlockMerge const *merge, struct BlockRange a, struct BlockRange b) {
+	size_t middle, amount;
+	
+	while ( blockLength(a) > 0 && blockLength(b) > 0 ) {
+		middle = blockBinaryFirst(merge, a.start, b);
+		amount = middle - a.end;
+		blockRotate(merge, blockLength(a), blockRange(a.start, middle), merge->cacheCount);
+		
+		if ( b.end == middle ) {
+			break;
+		}
+		
+		b.start = middle;
+		a = blockRange(a.start + amount, b.start);
+		a.start = blockBinaryLast(merge, a.start, a);
+	}
+}
+
+static void blockMergeLocal(struct BlockMerge const *merge, struct BlockRange a, struct BlockRange b, struct BlockRange buffer2) {
+	if ( blockLength(a) == 0 ) {
+		return;
+	} else if ( blockLength(a) <= merge->cacheCount ) {
+		blockMergeExternal(merge, a, b);
+	} else if ( blockLength(buffer2) > 0 ) {
+		blockMergeInternal(merge, a, b, buffer2);
+	} else {
+		blockMergeInPlace(merge, a, b);
+	}
+}
+
+struct BlockPull {
+	size_t from;
+	size_t to;
+	size_t count;
+	struct BlockRange range;
+};
+
+///	One level of merges without enough cache, pulling unique values out as internal buffers to tag the A blocks and to merge into
+static void blockMergeLevel(struct BlockMerge const *merge, struct BlockIterator *iterator) {
+	if ( SORTING_STATISTICS && merge->statistics ) {
+		merge->statistics->invocations += 1;
+	}
+	
+	struct BlockRange a, b, blockA, blockB, firstA, lastA, lastB, buffer1 = {0, 0}, buffer2 = {0, 0}, range;
+	struct BlockPull pulls[2] = {};
+	size_t length = iterator->decimalStep, blockSize = 1, bufferSize, find, index, last, count, start, indexA, minimumA, findA, split, remaining, amount, unique;
+	unsigned pull = 0, findSeparately = 0;
+	
+	while ( (blockSize + 1) * (blockSize + 1) <= length ) {
+		blockSize += 1;
+	}
+	
+	bufferSize = length / blockSize + 1;
+	find = bufferSize * 2;
+	
+	if ( blockSize <= merge->cacheCount ) {
+		//	every A block fits in the cache, so only the buffer of tags is needed
+		find = bufferSize;
+	} else if ( find > length ) {
+		find = bufferSize;
+		findSeparately = 1;
+	}
+	
+	//	find one range with two buffers of unique values, or two ranges with one each, or the largest buffer available
+	blockIteratorBegin(iterator);
+	
+	while ( !blockIteratorFinished(iterator) ) {
+		a = blockIteratorNext(iterator);
+		b = blockIteratorNext(iterator);
+		
+		for ( last = a.start, count = 1 ; count < find ; last = index, ++count ) {
+			index = blockFindLastForward(merge, last, blockRange(last + 1, a.end), find - count);
+			
+			if ( index == a.end ) {
+				break;
+			}
+		}
+		
+		index = last;
+		
+		if ( count >= bufferSize ) {
+			pulls[pull] = (struct BlockPull){index, a.start, count, blockRange(a.start, b.end)};
+			pull = 1;
+			
+			if ( count == bufferSize * 2 ) {
+				buffer1 = blockRange(a.start, a.start + bufferSize);
+				buffer2 = blockRange(a.start + bufferSize, a.start + count);
+				break;
+			} else if ( find == bufferSize * 2 ) {
+				buffer1 = blockRange(a.start, a.start + count);
+				find = bufferSize;
+			} else if ( blockSize <= merge->cacheCount ) {
+				buffer1 = blockRange(a.start, a.start + count);
+				break;
+			} else if ( findSeparately ) {
+				buffer1 = blockRange(a.start, a.start + count);
+				findSeparately = 0;
+			} else {
+				buffer2 = blockRange(a.start, a.start + count);
+				break;
+			}
+		} else if ( pull == 0 && count > blockLength(buffer1) ) {
+			buffer1 = blockRange(a.start, a.start + count);
+			pulls[pull] = (struct BlockPull){index, a.start, count, blockRange(a.start, b.end)};
+		}
+		
+		for ( last = b.end - 1, count = 1 ; count < find ; last = index - 1, ++count ) {
+			index = blockFindFirstBackward(merge, last, blockRange(b.start, last), find - count);
+			
+			if ( index == b.start ) {
+				break;
+			}
+		}
+		
+		index = last;
+		
+		if ( count >= bufferSize ) {
+			pulls[pull] = (struct BlockPull){index, b.end, count, blockRange(a.start, b.end)};
+			pull = 1;
+			
+			if ( count == bufferSize * 2 ) {
+				buffer1 = blockRange(b.end - count, b.end - bufferSize);
+				buffer2 = blockRange(b.end - bufferSize, b.end);
+				break;
+			} else if ( find == bufferSize * 2 ) {
+				buffer1 = blockRange(b.end - count, b.end);
+				find = bufferSize;
+			} else if ( blockSize <= merge->cacheCount ) {
+				buffer1 = blockRange(b.end - count, b.end);
+				break;
+			} else if ( findSeparately ) {
+				buffer1 = blockRange(b.end - count, b.end);
+				findSeparately = 0;
+			} else {
+				//	the first buffer from the matching A must stop redistributing before this one
+				if ( pulls[0].range.start == a.start ) {
+					pulls[0].range.end -= pulls[1].count;
+				}
+				
+				buffer2 = blockRange(b.end - count, b.end);
+				break;
+			}
+		} else if ( pull == 0 && count > blockLength(buffer1) ) {
+			buffer1 = blockRange(b.end - count, b.end);
+			pulls[pull] = (struct BlockPull){index, b.end, count, blockRange(a.start, b.end)};
+		}
+	}
+	
+	//	pull the unique values out to the start of A or the end of B
+	for ( pull = 0 ; pull < 2 ; ++pull ) {
+		length = pulls[pull].count;
+		
+		if ( pulls[pull].to < pulls[pull].from ) {
+			index = pulls[pull].from;
+			
+			for ( count = 1 ; count < length ; ++count ) {
+				index = blockFindFirstBackward(merge, index - 1, blockRange(pulls[pull].to, pulls[pull].from - (count - 1)), length - count);
+				range = blockRange(index + 1, pulls[pull].from + 1);
+				blockRotate(merge, blockLength(range) - count, range, merge->cacheCount);
+				pulls[pull].from = index + count;
+			}
+		} else if ( pulls[pull].to > pulls[pull].from ) {
+			index = pulls[pull].from + 1;
+			
+			for ( count = 1 ; count < length ; ++count ) {
+				index = blockFindLastForward(merge, index, blockRange(index, pulls[pull].to), length - count);
+				range = blockRange(pulls[pull].from, index - 1);
+				blockRotate(merge, count, range, merge->cacheCount);
+				pulls[pull].from = index - 1 - count;
+			}
+		}
+	}
+	
+	bufferSize = blockLength(buffer1);
+	blockSize = iterator->decimalStep / bufferSize + 1;
+	
+	blockIteratorBegin(iterator);
+	
+	while ( !blockIteratorFinished(iterator) ) {
+		a = blockIteratorNext(iterator);
+		b = blockIteratorNext(iterator);
+		start = a.start;
+		
+		//	exclude the internal buffers from the ranges being merged
+		for ( pull = 0 ; pull < 2 ; ++pull ) {
+			if ( start == pulls[pull].range.start ) {
+				if ( pulls[pull].from > pulls[pull].to ) {
+					a.start += pulls[pull].count;
+				} else if ( pulls[pull].from < pulls[pull].to ) {
+					b.end -= pulls[pull].count;
+				}
+			}
+		}
+		
+		if ( blockLength(a) == 0 || blockLength(b) == 0 ) {
+			continue;
+		}
+		
+		if ( blockIsLess(merge, b.end - 1, a.start) ) {
+			blockRotate(merge, blockLength(a), blockRange(a.start, b.end), merge->cacheCount);
+		} else if ( blockIsLess(merge, a.end, a.end - 1) ) {
+			blockA = a;
+			firstA = blockRange(a.start, a.start + blockLength(blockA) % blockSize);
+			
+			//	tag each even A block by swapping its first element with a unique value from buffer1
+			for ( indexA = buffer1.start, index = firstA.end ; index < blockA.end ; ++indexA, index += blockSize ) {
+				blockSwap(merge, indexA, index);
+			}
+			
+			lastA = firstA;
+			lastB = blockRange(0, 0);
+			blockB = blockRange(b.start, b.start + (blockSize < blockLength(b) ? blockSize : blockLength(b)));
+			blockA.start += blockLength(firstA);
+			indexA = buffer1.start;
+			
+			//	an empty A block has nothing to set aside, and the cache is NULL when space is zero
+			if ( blockLength(lastA) > 0 && blockLength(lastA) <= merge->cacheCount ) {
+				assignManyAt(merge->cache, 0, blockLength(lastA), merge->size, merge->array + lastA.start * merge->size, merge->statistics);
+			} else if ( blockLength(buffer2) > 0 ) {
+				blockSwapMany(merge, lastA.start, buffer2.start, blockLength(lastA));
+			}
+			
+			//	roll the A blocks through the B blocks, dropping the minimum A block behind where it belongs
+			while ( blockLength(blockA) > 0 ) {
+				if ( (blockLength(lastB) > 0 && !blockIsLess(merge, lastB.end - 1, indexA)) || blockLength(blockB) == 0 ) {
+					split = blockBinaryFirst(merge, indexA, lastB);
+					remaining = lastB.end - split;
+					
+					//	the tags order blocks with equal first elements, so the minimum is stable
+					for ( minimumA = blockA.start, findA = minimumA + blockSize ; findA < blockA.end ; findA += blockSize ) {
+						if ( blockIsLess(merge, findA, minimumA) ) {
+							minimumA = findA;
+						}
+					}
+					
+					blockSwapMany(merge, blockA.start, minimumA, blockSize);
+					blockSwap(merge, blockA.start, indexA);
+					indexA += 1;
+					
+					blockMergeLocal(merge, lastA, blockRange(lastA.end, split), buffer2);
+					
+					if ( blockLength(buffer2) > 0 || blockSize <= merge->cacheCount ) {
+						if ( blockSize <= merge->cacheCount ) {
+							assignManyAt(merge->cache, 0, blockSize, merge->size, merge->array + blockA.start * merge->size, merge->statistics);
+						} else {
+							blockSwapMany(merge, blockA.start, buffer2.start, blockSize);
+						}
+						
+						blockSwapMany(merge, split, blockA.start + blockSize - remaining, remaining);
+					} else {
+						blockRotate(merge, blockA.start - split, blockRange(split, blockA.start + blockSize), merge->cacheCount);
+					}
+					
+					lastA = blockRange(blockA.start - remaining, blockA.start - remaining + blockSize);
+					lastB = blockRange(lastA.end, lastA.end + remaining);
+					blockA.start += blockSize;
+				} else if ( blockLength(blockB) < blockSize ) {
+					//	the cache may hold the previous A block, so rotate the uneven last B block without it
+					blockRotate(merge, blockB.start - blockA.start, blockRange(blockA.start, blockB.end), 0);
+					lastB = blockRange(blockA.start, blockA.start + blockLength(blockB));
+					blockA.start += blockLength(blockB);
+					blockA.end += blockLength(blockB);
+					blockB.end = blockB.start;
+				} else {
+					blockSwapMany(merge, blockA.start, blockB.start, blockSize);
+					lastB = blockRange(blockA.start, blockA.start + blockSize);
+					blockA.start += blockSize;
+					blockA.end += blockSize;
+					blockB.start += blockSize;
+					blockB.end = blockB.end > b.end - blockSize ? b.end : blockB.end + blockSize;
+				}
+			}
+			
+			blockMergeLocal(merge, lastA, blockRange(lastA.end, b.end), buffer2);
+		}
+	}
+	
+	//	the second buffer was jumbled by the internal merges, then both buffers are redistributed to where their values belong
+	blockInsertionSort(merge, buffer2);
+	
+	for ( pull = 0 ; pull < 2 ; ++pull ) {
+		unique = pulls[pull].count * 2;
+		
+		if ( pulls[pull].from > pulls[pull].to ) {
+			range = blockRange(pulls[pull].range.start, pulls[pull].range.start + pulls[pull].count);
+			
+			while ( blockLength(range) > 0 ) {
+				index = blockFindFirstForward(merge, range.start, blockRange(range.end, pulls[pull].range.end), unique);
+				amount = index - range.end;
+				blockRotate(merge, blockLength(range), blockRange(range.start, index), merge->cacheCount);
+				range.start += amount + 1;
+				range.end += amount;
+				unique -= 2;
+			}
+		} else if ( pulls[pull].from < pulls[pull].to ) {
+			range = blockRange(pulls[pull].range.end - pulls[pull].count, pulls[pull].range.end);
+			
+			while ( blockLength(range) > 0 ) {
+				index = blockFindLastBackward(merge, range.end - 1, blockRange(pulls[pull].range.start, range.start), unique);
+				amount = range.start - index;
+				blockRotate(merge, amount, blockRange(index, range.end), merge->cacheCount);
+				range.start -= amount;
+				range.end -= amount + 1;
+				unique -= 2;
+			}
+		}
+	}
+}
+
+///	Stable block merge sort in the style of WikiSort, buffer holds space bytes used as one temporary element and a cache of any more elements, sorting in O(n log n) without any other memory even when space is zero
+void blockMergeSort(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context) {
+	struct BlockMerge merge = {array, size, NULL, NULL, 0, statistics, compare, context};
+	
+	//	without room for one element swaps go byte by byte and there is no cache
+	if ( buffer && space >= size ) {
+		merge.temporary = buffer;
+		merge.cache = buffer + size;
+		merge.cacheCount = space / size - 1;
+	}
+	
+	if ( count < kBlockMinimumLevel * 2 ) {
+		blockInsertionSort(&merge, blockRange(0, count));
+		return;
+	}
+	
+	struct BlockIterator iterator = blockIterator(count, kBlockMinimumLevel);
+	struct BlockRange a, b;
+	
+	//	sort the smallest ranges, with coleSort when the cache can hold them so natural runs are found
+	while ( !blockIteratorFinished(&iterator) ) {
+		a = blockIteratorNext(&iterator);
+		
+		if ( blockLength(a) <= merge.cacheCount ) {
+			coleSort(array + a.start * size, merge.cache, blockLength(a), size, statistics, compare, context);
+		} else {
+			blockInsertionSort(&merge, a);
+		}
+	}
+	
+	do {
+		if ( iterator.decimalStep < merge.cacheCount ) {
+			//	every A range fits in the cache
+			blockIteratorBegin(&iterator);
+			
+			while ( !blockIteratorFinished(&iterator) ) {
+				a = blockIteratorNext(&iterator);
+				b = blockIteratorNext(&iterator);
+				
+				if ( blockIsLess(&merge, b.end - 1, a.start) ) {
+					blockRotate(&merge, blockLength(a), blockRange(a.start, b.end), merge.cacheCount);
+				} else if ( blockIsLess(&merge, b.start, a.end - 1) ) {
+					assignManyAt(merge.cache, 0, blockLength(a), size, array + a.start * size, statistics);
+					blockMergeExternal(&merge, a, b);
+				}
+			}
+		} else {
+			blockMergeLevel(&merge, &iterator);
+		}
+	} while ( blockIteratorNextLevel(&iterator) );
+}
+
+//	MARK: - Heap Sort
+
+static void heapSift(void *array, size_t start, size_t end, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t i = start, j = start;
+	size_t a, b;
+	unsigned d = 0;
+	
+	while ( j * 2 + 2 <= end ) {
+		if ( invokeIsLess(array + (j * 2 + 1) * size, array + (j * 2 + 2) * size, statistics, compare, context) ) {
+			j = j * 2 + 2;
+		} else {
+			j = j * 2 + 1;
+		}
+		d += 1;
+	}
+	
+	while ( j * 2 + 1 <= end ) {
+		j = j * 2 + 1;
+		d += 1;
+	}
+	
+	while ( invokeIsLess(array + j * size, array + i * size, statistics, compare, context) ) {
+		j = (j - 1) / 2;
+		d -= 1;
+	}
+	
+	if ( d > 0 ) {
+		accessAt(array, i, size, temporary, statistics);
+		
+		while ( d --> 0 ) {
+			a = (j + 1 - (1 << d)) >> d;
+			b = (a - 1) >> 1;
+			assignAt(array, b, size, array + a * size, statistics);
+		}
+		
+		assignAt(array, j, size, temporary, statistics);
+	}
+}
+
+static void heapBuild(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t start = count / 2;
+	
+	while ( start > 0 ) {
+		start -= 1;
+		
+		heapSift(array, start, count - 1, size, temporary, statistics, compare, context);
+	}
+}
+
+static void heapExtract(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t end = count - 1;
+	
+	while ( end > 0 ) {
+		swapAt(array, 0, end, size, temporary, statistics);
+		
+		end -= 1;
+		
+		heapSift(array, 0, end, size, temporary, statistics, compare, context);
+	}
+}
+
+///	Heap Sort organizes elements into a heap then extracts elements from the heap in sorted order
+void heapSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	heapBuild(array, count, size, temporary, statistics, compare, context);
+	heapExtract(array, count, size, temporary, statistics, compare, context);
+}
+
+//	MARK: - Quick Sort
+
+static size_t quickPartition(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t pivot = count / 2;
+	size_t lower = 0, upper = count - 1;
+	
+	if ( invokeIsLess(array + pivot * size, array + lower * size, statistics, compare, context) ) {
+		swapAt(array, pivot, lower, size, temporary, statistics);
+	}
+	
+	if ( invokeIsLess(array + upper * size, array + pivot * size, statistics, compare, context) ) {
+		swapAt(array, pivot, upper, size, temporary, statistics);
+		
+		if ( invokeIsLess(array + pivot * size, array + lower * size, statistics, compare, context) ) {
+			swapAt(array, pivot, lower, size, temporary, statistics);
+		}
+	}
+	
+	for ( ;; ) {
+		do {
+			lower += 1;
+		} while ( invokeIsLess(array + lower * size, array + pivot * size, statistics, compare, context) );
+		
+		do {
+			upper -= 1;
+		} while ( invokeIsLess(array + pivot * size, array + upper * size, statistics, compare, context) );
+		
+		if ( lower < upper ) {
+			swapAt(array, lower, upper, size, temporary, statistics);
+			
+			if ( pivot == lower ) {
+				pivot = upper;
+			} else if ( pivot == upper ) {
+				pivot = lower;
+			}
+		} else {
+			break;
+		}
+	}
+	
+	return 1 + upper;
+}
+
+static void quickSortRange(void *array, size_t count, size_t size, size_t network, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( count < 2 ) {
+		return;
+	} else if ( count <= network ) {
+		networkSortCounted(array, array, count, size, statistics, compare);
+	} else if ( count < 16 ) {
+		binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+	} else {
+		size_t pivot = quickPartition(array, count, size, temporary, statistics, compare, context);
+		
+		quickSortRange(array, pivot, size, network, temporary, statistics, compare, context);
+		quickSortRange(array + pivot * size, count - pivot, size, network, temporary, statistics, compare, context);
+	}
+}
+
+///	Quick sort identifies a pivot element then swaps elements on the wrong side of the pivot
+void quickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t network = networkSortWidth(size, compare);
+	
+	switch ( size ) {
+	case 4: quickSortRange(array, count, 4, network, temporary, statistics, compare, context); break;
+	case 8: quickSortRange(array, count, 8, network, temporary, statistics, compare, context); break;
+	case 16: quickSortRange(array, count, 16, network, temporary, statistics, compare, context); break;
+	default: quickSortRange(array, count, size, network, temporary, statistics, compare, context); break;
+	}
+}
+
+/// Self balancing quick sort that use an alternate sorting algorithm on affected regions after several pivots in a row are imbalanced
+void balancingQuickSort(void *array, size_t count, size_t size, unsigned imbalances, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( count < 2 ) {
+		return;
+	} else if ( count < 16 ) {	//	higher threshold will decrease comparisons and increase assignments
+		binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+	} else if ( imbalances > 4 ) {
+		heapSort(array, count, size, temporary, statistics, compare, context);
+	} else {
+		size_t pivot = quickPartition(array, count, size, temporary, statistics, compare, context);
+		size_t ratio = 12;
+		
+		imbalances = count > ratio * (count - pivot - 1 < pivot ? count - pivot - 1 : pivot) ? imbalances + 1 : 0;
+		
+		balancingQuickSort(array, pivot, size, imbalances, temporary, statistics, compare, context);
+		balancingQuickSort(array + pivot * size, count - pivot, size, imbalances, temporary, statistics, compare, context);
+	}
+}
+
+//	MARK: - Pattern Defeating Quick Sort
+
+#define kPatternBlock 64
+#define kPatternInsertion 24
+#define kPatternNinther 128
+
+static inline void patternSortTwo(void *array, size_t a, size_t b, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( invokeIsLess(array + b * size, array + a * size, statistics, compare, context) ) {
+		swapAt(array, a, b, size, temporary, statistics);
+	}
+}
+
+static inline void patternSortThree(void *array, size_t a, size_t b, size_t c, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	patternSortTwo(array, a, b, size, temporary, statistics, compare, context);
+	patternSortTwo(array, b, c, size, temporary, statistics, compare, context);
+	patternSortTwo(array, a, b, size, temporary, statistics, compare, context);
+}
+
+///	Insertion sort that gives up after a few moves, returns whether the range is sorted
+static unsigned patternPartialInsertionSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t index, at, moves = 0;
+	
+	for ( index = 1 ; index < count ; ++index ) {
+		for ( at = index ; at > 0 && invokeIsLess(array + index * size, array + (at - 1) * size, statistics, compare, context) ; --at ) {}
+		
+		if ( at < index ) {
+			slideDown(array, index, at, size, temporary, statistics);
+			moves += index - at;
+			
+			if ( moves > 8 ) {
+				return 0;
+			}
+		}
+	}
+	
+	return 1;
+}
+
+///	Partition around the pivot at array[0] with equal elements going left, used when the preceding pivot equals this one, returns the pivot position
+static size_t patternPartitionLeft(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t lower = 0, upper = count;
+	
+	while ( invokeIsLess(array, array + --upper * size, statistics, compare, context) ) {}
+	
+	if ( upper + 1 == count ) {
+		while ( lower < upper && !invokeIsLess(array, array + ++lower * size, statistics, compare, context) ) {}
+	} else {
+		while ( !invokeIsLess(array, array + ++lower * size, statistics, compare, context) ) {}
+	}
+	
+	while ( lower < upper ) {
+		swapAt(array, lower, upper, size, temporary, statistics);
+		
+		while ( invokeIsLess(array, array + --upper * size, statistics, compare, context) ) {}
+		while ( !invokeIsLess(array, array + ++lower * size, statistics, compare, context) ) {}
+	}
+	
+	swapAt(array, 0, upper, size, temporary, statistics);
+	
+	return upper;
+}
+
+///	Exchange the misplaced elements found by two blocks, as a cyclic rotation through one temporary unless the counts match
+static inline void patternSwapOffsets(void *array, size_t lowerBase, size_t upperBase, unsigned char const *lowerOffsets, unsigned char const *upperOffsets, size_t count, unsigned swaps, size_t size, void *temporary, struct SortingStatistics *statistics) {
+	size_t index, l, r;
+	
+	if ( swaps ) {
+		for ( index = 0 ; index < count ; ++index ) {
+			swapAt(array, lowerBase + lowerOffsets[index], upperBase - upperOffsets[index], size, temporary, statistics);
+		}
+	} else if ( count > 0 ) {
+		l = lowerBase + lowerOffsets[0];
+		r = upperBase - upperOffsets[0];
+		accessAt(array, l, size, temporary, statistics);
+		assignAt(array, l, size, array + r * size, statistics);
+		
+		for ( index = 1 ; index < count ; ++index ) {
+			l = lowerBase + lowerOffsets[index];
+			assignAt(array, r, size, array + l * size, statistics);
+			r = upperBase - upperOffsets[index];
+			assignAt(array, l, size, array + r * size, statistics);
+		}
+		
+		assignAt(array, r, size, temporary, statistics);
+	}
+}
+
+///	Block partition around the pivot at array[0], recording misplaced elements of each block as byte offsets so the comparisons do not branch, returns the pivot position
+static size_t patternPartitionRight(void *array, size_t count, size_t size, unsigned *partitioned, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	unsigned char lowerOffsets[kPatternBlock], upperOffsets[kPatternBlock];
+	size_t lower = 0, upper = count, index;
+	
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	//	the median of three guarantees an element on each side that stops these scans
+	while ( invokeIsLess(array + ++lower * size, array, statistics, compare, context) ) {}
+	
+	if ( lower == 1 ) {
+		while ( lower < upper && !invokeIsLess(array + --upper * size, array, statistics, compare, context) ) {}
+	} else {
+		while ( !invokeIsLess(array + --upper * size, array, statistics, compare, context) ) {}
+	}
+	
+	*partitioned = lower >= upper;
+	
+	if ( lower < upper ) {
+		size_t lowerCount = 0, upperCount = 0, lowerStart = 0, upperStart = 0;
+		size_t lowerBase, upperBase, unknown, lowerSplit, upperSplit, exchanges;
+		
+		swapAt(array, lower, upper, size, temporary, statistics);
+		lower += 1;
+		lowerBase = lower;
+		upperBase = upper;
+		
+		while ( lower < upper ) {
+			unknown = upper - lower;
+			lowerSplit = lowerCount == 0 ? (upperCount == 0 ? unknown / 2 : unknown) : 0;
+			upperSplit = upperCount == 0 ? unknown - lowerSplit : 0;
+			lowerSplit = lowerSplit < kPatternBlock ? lowerSplit : kPatternBlock;
+			upperSplit = upperSplit < kPatternBlock ? upperSplit : kPatternBlock;
+			
+			for ( index = 0 ; index < lowerSplit ; ++index ) {
+				lowerOffsets[lowerCount] = (unsigned char)index;
+				lowerCount += !invokeIsLess(array + lower++ * size, array, statistics, compare, context);
+			}
+			
+			for ( index = 0 ; index < upperSplit ; ) {
+				upperOffsets[upperCount] = (unsigned char)++index;
+				upperCount += invokeIsLess(array + --upper * size, array, statistics, compare, context);
+			}
+			
+			exchanges = lowerCount < upperCount ? lowerCount : upperCount;
+			patternSwapOffsets(array, lowerBase, upperBase, lowerOffsets + lowerStart, upperOffsets + upperStart, exchanges, lowerCount == upperCount, size, temporary, statistics);
+			lowerCount -= exchanges;
+			upperCount -= exchanges;
+			lowerStart += exchanges;
+			upperStart += exchanges;
+			
+			if ( lowerCount == 0 ) {
+				lowerStart = 0;
+				lowerBase = lower;
+			}
+			
+			if ( upperCount == 0 ) {
+				upperStart = 0;
+				upperBase = upper;
+			}
+		}
+		
+		//	one block has misplaced elements left over, move them to the boundary
+		while ( lowerCount ) {
+			lowerCount -= 1;
+			swapAt(array, lowerBase + lowerOffsets[lowerStart + lowerCount], --upper, size, temporary, statistics);
+			lower = upper;
+		}
+		
+		while ( upperCount ) {
+			upperCount -= 1;
+			swapAt(array, upperBase - upperOffsets[upperStart + upperCount], lower++, size, temporary, statistics);
+		}
+	}
+	
+	swapAt(array, 0, lower - 1, size, temporary, statistics);
+	
+	return lower - 1;
+}
+
+///	Swap a few elements a quarter of the way in from each end of a badly partitioned range, breaking patterns that defeat the pivot selection
+static void patternShuffle(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics) {
+	if ( count < kPatternInsertion ) {
+		return;
+	}
+	
+	size_t quarter = count / 4;
+	
+	swapAt(array, 0, quarter, size, temporary, statistics);
+	swapAt(array, count - 1, count - quarter, size, temporary, statistics);
+	
+	if ( count > kPatternNinther ) {
+		swapAt(array, 1, quarter + 1, size, temporary, statistics);
+		swapAt(array, 2, quarter + 2, size, temporary, statistics);
+		swapAt(array, count - 2, count - quarter - 1, size, temporary, statistics);
+		swapAt(array, count - 3, count - quarter - 2, size, temporary, statistics);
+	}
+}
+
+static void patternDefeatingQuickSortRange(void *array, size_t count, size_t size, size_t network, unsigned leftmost, unsigned imbalances, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t half, pivot;
+	unsigned partitioned;
+	
+	for ( ;; ) {
+		if ( count <= network ) {
+			networkSortCounted(array, array, count, size, statistics, compare);
+			return;
+		} else if ( count < kPatternInsertion ) {
+			binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+			return;
+		}
+		
+		//	ninther of medians on large ranges, median of three otherwise, moved to array[0]
+		half = count / 2;
+		
+		if ( count > kPatternNinther ) {
+			patternSortThree(array, 0, half, count - 1, size, temporary, statistics, compare, context);
+			patternSortThree(array, 1, half - 1, count - 2, size, temporary, statistics, compare, context);
+			patternSortThree(array, 2, half + 1, count - 3, size, temporary, statistics, compare, context);
+			patternSortThree(array, half - 1, half, half + 1, size, temporary, statistics, compare, context);
+			swapAt(array, 0, half, size, temporary, statistics);
+		} else {
+			patternSortThree(array, half, 0, count - 1, size, temporary, statistics, compare, context);
+		}
+		
+		//	the pivot equals the preceding pivot, so every element equal to it is already in place
+		if ( !leftmost && !invokeIsLess(array - size, array, statistics, compare, context) ) {
+			pivot = patternPartitionLeft(array, count, size, temporary, statistics, compare, context) + 1;
+			array += pivot * size;
+			count -= pivot;
+			continue;
+		}
+		
+		pivot = patternPartitionRight(array, count, size, &partitioned, temporary, statistics, compare, context);
+		
+		if ( pivot < count / 8 || count - pivot - 1 < count / 8 ) {
+			if ( --imbalances == 0 ) {
+				heapSort(array, count, size, temporary, statistics, compare, context);
+				return;
+			}
+			
+			patternShuffle(array, pivot, size, temporary, statistics);
+			patternShuffle(array + (pivot + 1) * size, count - pivot - 1, size, temporary, statistics);
+		} else if ( partitioned
+			&& patternPartialInsertionSort(array, pivot, size, temporary, statistics, compare, context)
+			&& patternPartialInsertionSort(array + (pivot + 1) * size, count - pivot - 1, size, temporary, statistics, compare, context) ) {
+			return;
+		}
+		
+		patternDefeatingQuickSortRange(array, pivot, size, network, leftmost, imbalances, temporary, statistics, compare, context);
+		array += (pivot + 1) * size;
+		count -= pivot + 1;
+		leftmost = 0;
+	}
+}
+
+///	Pattern defeating quick sort with branchless block partitioning, ninther pivots, detection of partitioned ranges, shuffling of adversarial ranges, and a heap sort fallback
+void patternDefeatingQuickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t network = networkSortWidth(size, compare);
+	unsigned imbalances = 1;
+	
+	while ( count >> imbalances ) {
+		imbalances += 1;
+	}
+	
+	switch ( size ) {
+	case 4: patternDefeatingQuickSortRange(array, count, 4, network, 1, imbalances, temporary, statistics, compare, context); break;
+	case 8: patternDefeatingQuickSortRange(array, count, 8, network, 1, imbalances, temporary, statistics, compare, context); break;
+	case 16: patternDefeatingQuickSortRange(array, count, 16, network, 1, imbalances, temporary, statistics, compare, context); break;
+	default: patternDefeatingQuickSortRange(array, count, size, network, 1, imbalances, temporary, statistics, compare, context); break;
+	}
+}
+
+//	MARK: - Three Way Quick Sort
+
+static inline void threeWaySwapMany(void *array, size_t from, size_t to, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics) {
+	while ( count-- ) {
+		swapAt(array, from++, to++, size, temporary, statistics);
+	}
+}
+
+///	Bentley McIlroy partition around the pivot at array[0], gathering equal elements at both ends then swapping them to the middle, returns the count of lesser elements and sets the count of greater elements
+static size_t threeWayPartition(void *array, size_t count, size_t size, size_t *greater, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t lowerEqual = 1, lower = 1, upper = count - 1, upperEqual = count - 1, equal;
+	signed c;
+	
+	for ( ;; ) {
+		while ( lower <= upper && (c = invokeCompare(array + lower * size, array, statistics, compare, context)) <= 0 ) {
+			if ( c == 0 ) {
+				swapAt(array, lowerEqual++, lower, size, temporary, statistics);
+			}
+			
+			lower += 1;
+		}
+		
+		while ( lower <= upper && (c = invokeCompare(array + upper * size, array, statistics, compare, context)) >= 0 ) {
+			if ( c == 0 ) {
+				swapAt(array, upper, upperEqual--, size, temporary, statistics);
+			}
+			
+			upper -= 1;
+		}
+		
+		if ( lower > upper ) {
+			break;
+		}
+		
+		swapAt(array, lower++, upper--, size, temporary, statistics);
+	}
+	
+	//	[0, lowerEqual) equal, [lowerEqual, lower) less, (upper, upperEqual] greater, (upperEqual, count) equal
+	equal = lowerEqual < lower - lowerEqual ? lowerEqual : lower - lowerEqual;
+	threeWaySwapMany(array, 0, lower - equal, equal, size, temporary, statistics);
+	equal = upperEqual - upper < count - 1 - upperEqual ? upperEqual - upper : count - 1 - upperEqual;
+	threeWaySwapMany(array, lower, count - equal, equal, size, temporary, statistics);
+	
+	*greater = upperEqual - upper;
+	
+	return lower - lowerEqual;
+}
+
+static void threeWayQuickSortRange(void *array, size_t count, size_t size, size_t network, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t lesser, greater, half;
+	
+	for ( ;; ) {
+		if ( count < 2 ) {
+			return;
+		} else if ( count <= network ) {
+			networkSortCounted(array, array, count, size, statistics, compare);
+			return;
+		} else if ( count < 16 ) {
+			binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+			return;
+		}
+		
+		half = count / 2;
+		
+		if ( count > kPatternNinther ) {
+			patternSortThree(array, 0, half, count - 1, size, temporary, statistics, compare, context);
+			patternSortThree(array, 1, half - 1, count - 2, size, temporary, statistics, compare, context);
+			patternSortThree(array, 2, half + 1, count - 3, size, temporary, statistics, compare, context);
+			patternSortThree(array, half - 1, half, half + 1, size, temporary, statistics, compare, context);
+			swapAt(array, 0, half, size, temporary, statistics);
+		} else {
+			patternSortThree(array, half, 0, count - 1, size, temporary, statistics, compare, context);
+		}
+		
+		lesser = threeWayPartition(array, count, size, &greater, temporary, statistics, compare, context);
+		
+		//	elements equal to the pivot are in place, recurse into the smaller side and loop on the larger
+		if ( lesser < greater ) {
+			threeWayQuickSortRange(array, lesser, size, network, temporary, statistics, compare, context);
+			array += (count - greater) * size;
+			count = greater;
+		} else {
+			threeWayQuickSortRange(array + (count - greater) * size, greater, size, network, temporary, statistics, compare, context);
+			count = lesser;
+		}
+	}
+}
+
+///	Quick sort with a fat pivot that gathers every element equal to the pivot into the middle and excludes them from recursion, so input with k distinct keys sorts in O(n log k)
+void threeWayQuickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t network = networkSortWidth(size, compare);
+	
+	switch ( size ) {
+	case 4: threeWayQuickSortRange(array, count, 4, network, temporary, statistics, compare, context); break;
+	case 8: threeWayQuickSortRange(array, count, 8, network, temporary, statistics, compare, context); break;
+	case 16: threeWayQuickSortRange(array, count, 16, network, temporary, statistics, compare, context); break;
+	default: threeWayQuickSortRange(array, count, size, network, temporary, statistics, compare, context); break;
+	}
+}
+
+//	MARK: - Selection
+
+//	selecting with a heap wins while k is below count / kPartialHeapRatio
+#define kPartialHeapRatio 32
+
+///	Gather the k least elements into a max heap at the front, each later element only replaces the root when it is less
+static void partialHeapSelect(void *array, size_t count, size_t k, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t index;
+	
+	heapBuild(array, k, size, temporary, statistics, compare, context);
+	
+	for ( index = k ; index < count ; ++index ) {
+		if ( invokeIsLess(array + index * size, array, statistics, compare, context) ) {
+			swapAt(array, 0, index, size, temporary, statistics);
+			heapSift(array, 0, k - 1, size, temporary, statistics, compare, context);
+		}
+	}
+}
+
+///	Introselect that partitions only the side holding nth around a median of three, stopping once nth is among the elements equal to the pivot, then selects with a heap after several imbalanced partitions in a row
+static void quickSelectRange(void *array, size_t count, size_t nth, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t lesser, greater, ratio = 12;
+	unsigned imbalances = 0;
+	
+	while ( count > 1 ) {
+		if ( count < 16 ) {
+			binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+			return;
+		} else if ( imbalances > 4 ) {
+			//	the root of a max heap of the nth + 1 least elements belongs at nth
+			partialHeapSelect(array, count, nth + 1, size, temporary, statistics, compare, context);
+			swapAt(array, 0, nth, size, temporary, statistics);
+			return;
+		}
+		
+		patternSortThree(array, count / 2, 0, count - 1, size, temporary, statistics, compare, context);
+		lesser = threeWayPartition(array, count, size, &greater, temporary, statistics, compare, context);
+		imbalances = count > ratio * (count - (lesser > greater ? lesser : greater)) ? imbalances + 1 : 0;
+		
+		//	elements equal to the pivot are in place and excluded from either side
+		if ( nth < lesser ) {
+			count = lesser;
+		} else if ( nth < count - greater ) {
+			return;
+		} else {
+			array += (count - greater) * size;
+			nth -= count - greater;
+			count = greater;
+		}
+	}
+}
+
+static void quickMultiSelectRange(void *array, size_t count, size_t offset, size_t const *nths, size_t nthCount, unsigned imbalances, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	size_t lesser, greater, split, ratio = 12;
+	
+	while ( nthCount > 1 ) {
+		if ( count < 16 ) {
+			binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
+			return;
+		} else if ( imbalances > 4 ) {
+			heapSort(array, count, size, temporary, statistics, compare, context);
+			return;
+		}
+		
+		patternSortThree(array, count / 2, 0, count - 1, size, temporary, statistics, compare, context);
+		lesser = threeWayPartition(array, count, size, &greater, temporary, statistics, compare, context);
+		imbalances = count > ratio * (count - (lesser > greater ? lesser : greater)) ? imbalances + 1 : 0;
+		
+		for ( split = 0 ; split < nthCount && nths[split] < offset + lesser ; ++split ) {}
+		
+		//	each side only continues with the indices that fall within it
+		quickMultiSelectRange(array, lesser, offset, nths, split, imbalances, size, temporary, statistics, compare, context);
+		
+		//	indices among the elements equal to the pivot are already placed
+		for ( ; split < nthCount && nths[split] < offset + count - greater ; ++split ) {}
+		
+		array += (count - greater) * size;
+		offset += count - greater;
+		count = greater;
+		nths += split;
+		nthCount -= split;
+	}
+	
+	if ( nthCount ) {
+		quickSelectRange(array, count, nths[0] - offset, size, temporary, statistics, compare, context);
+	}
+}
+
+///	Place the element that belongs at index nth when sorted, no element before it is greater and no element after it is less
+void quickSelect(void *array, size_t count, size_t nth, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( nth < count ) {
+		quickSelectRange(array, count, nth, size, temporary, statistics, compare, context);
+	}
+}
+
+///	Place the elements that belong at several ascending indices when sorted, like the 50th, 90th and 99th percentiles, sharing the partitions above them
+void quickMultiSelect(void *array, size_t count, size_t const *nths, size_t nthCount, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	while ( nthCount > 0 && !(nths[nthCount - 1] < count) ) {
+		nthCount -= 1;
+	}
+	
+	quickMultiSelectRange(array, count, 0, nths, nthCount, 0, size, temporary, statistics, compare, context);
+}
+
+///	Sort only the k least elements into the front of the array, the order of the remaining elements is unspecified
+void partialSort(void *array, size_t count, size_t k, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	k = k < count ? k : count;
+	
+	if ( !k ) {
+		return;
+	} else if ( k < count / kPartialHeapRatio ) {
+		partialHeapSelect(array, count, k, size, temporary, statistics, compare, context);
+		heapExtract(array, k, size, temporary, statistics, compare, context);
+	} else {
+		if ( k < count ) {
+			quickSelectRange(array, count, k - 1, size, temporary, statistics, compare, context);
+		}
+		
+		patternDefeatingQuickSort(array, k, size, temporary, statistics, compare, context);
+	}
+}
+
+//	MARK: - Parallel Quick Sort
+
+#define kParallelQuickCutoff 16384
+#define kParallelQuickCapacity 256
+
+struct QuickTask {
+	void *array;
+	size_t count;
+	unsigned imbalances;
+};
+
+///	Each worker pushes and pops tasks at the top of its own queue while idle workers steal from the bottom
+struct QuickWorker {
+	pthread_mutex_t lock;
+	struct QuickTask tasks[kParallelQuickCapacity];
+	unsigned bottom;
+	unsigned top;
+	unsigned index;
+	void *temporary;
+	struct SortingStatistics statistics;
+	struct SortingStatistics *counting;
+	struct QuickPool *pool;
+};
+
+struct QuickPool {
+	struct QuickWorker *workers;
+	unsigned threads;
+	size_t pending;
+	size_t size;
+	Compare *compare;
+	void *context;
+};
+
+static unsigned quickWorkerPush(struct QuickWorker *worker, struct QuickTask task) {
+	unsigned pushed = 0;
+	
+	pthread_mutex_lock(&worker->lock);
+	
+	if ( worker->top < kParallelQuickCapacity ) {
+		__atomic_add_fetch(&worker->pool->pending, 1, __ATOMIC_SEQ_CST);
+		worker->tasks[worker->top++] = task;
+		pushed = 1;
+	}
+	
+	pthread_mutex_unlock(&worker->lock);
+	
+	return pushed;
+}
+
+static unsigned quickWorkerTake(struct QuickWorker *worker, struct QuickTask *task, unsigned steal) {
+	unsigned taken = 0;
+	
+	pthread_mutex_lock(&worker->lock);
+	
+	if ( worker->bottom < worker->top ) {
+		*task = steal ? worker->tasks[worker->bottom++] : worker->tasks[--worker->top];
+		taken = 1;
+	}
+	
+	if ( worker->bottom == worker->top ) {
+		worker->bottom = 0;
+		worker->top = 0;
+	}
+	
+	pthread_mutex_unlock(&worker->lock);
+	
+	return taken;
+}
+
+///	Partition until the task is below the cutoff, queueing the upper partitions for any worker to take
+static void quickWorkerPerform(struct QuickWorker *worker, struct QuickTask task) {
+	struct QuickPool *pool = worker->pool;
+	size_t size = pool->size, pivot, ratio = 12;
+	struct QuickTask upper;
+	
+	while ( task.count >= kParallelQuickCutoff && task.imbalances <= 4 ) {
+		pivot = quickPartition(task.array, task.count, size, worker->temporary, worker->counting, pool->compare, pool->context);
+		
+		task.imbalances = task.count > ratio * (task.count - pivot - 1 < pivot ? task.count - pivot - 1 : pivot) ? task.imbalances + 1 : 0;
+		
+		upper.array = task.array + pivot * size;
+		upper.count = task.count - pivot;
+		upper.imbalances = task.imbalances;
+		
+		if ( !quickWorkerPush(worker, upper) ) {
+			balancingQuickSort(upper.array, upper.count, size, upper.imbalances, worker->temporary, worker->counting, pool->compare, pool->context);
+		}
+		
+		task.count = pivot;
+	}
+	
+	balancingQuickSort(task.array, task.count, size, task.imbalances, worker->temporary, worker->counting, pool->compare, pool->context);
+	
+	__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_SEQ_CST);
+}
+
+static void *quickWorkerRun(void *argument) {
+	struct QuickWorker *worker = argument;
+	struct QuickPool *pool = worker->pool;
+	struct QuickTask task;
+	unsigned i;
+	
+	while ( __atomic_load_n(&pool->pending, __ATOMIC_SEQ_CST) > 0 ) {
+		if ( quickWorkerTake(worker, &task, 0) ) {
+			quickWorkerPerform(worker, task);
+			continue;
+		}
+		
+		for ( i = 1 ; i < pool->threads ; ++i ) {
+			if ( quickWorkerTake(&pool->workers[(worker->index + i) % pool->threads], &task, 1) ) {
+				quickWorkerPerform(worker, task);
+				break;
+			}
+		}
+		
+		if ( i == pool->threads ) {
+			sched_yield();
+		}
+	}
+	
+	return NULL;
+}
+
+///	Balancing quick sort that partitions large regions on a pool of work stealing threads, sorting in place
+void parallelBalancingQuickSort(void *array, size_t count, size_t size, unsigned imbalances, unsigned threads, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	threads = threads < kParallelMaximumThreads ? threads : kParallelMaximumThreads;
+	
+	if ( threads < 2 || count < kParallelQuickCutoff * 2 ) {
+		balancingQuickSort(array, count, size, imbalances, temporary, statistics, compare, context);
+		return;
+	}
+	
+	//	each worker has its own temporary element after the workers
+	struct QuickWorker *workers = calloc(threads, sizeof(struct QuickWorker) + size);
+	
+	if ( !workers ) {
+		balancingQuickSort(array, count, size, imbalances, temporary, statistics, compare, context);
+		return;
+	}
+	
+	unsigned char *temporaries = (unsigned char *)(workers + threads);
+	pthread_t handles[kParallelMaximumThreads];
+	unsigned created[kParallelMaximumThreads];
+	struct QuickPool pool = {workers, threads, 0, size, compare, context};
+	struct QuickTask task = {array, count, imbalances};
+	unsigned i;
+	
+	for ( i = 0 ; i < threads ; ++i ) {
+		pthread_mutex_init(&workers[i].lock, NULL);
+		workers[i].index = i;
+		workers[i].temporary = temporaries + i * size;
+		workers[i].counting = SORTING_STATISTICS && statistics ? &workers[i].statistics : NULL;
+		workers[i].pool = &pool;
+	}
+	
+	quickWorkerPush(&workers[0], task);
+	
+	for ( i = 1 ; i < threads ; ++i ) {
+		created[i] = 0 == pthread_create(&handles[i], NULL, quickWorkerRun, &workers[i]);
+	}
+	
+	//	the calling thread is a worker too, so the sort completes even when no thread could be created
+	quickWorkerRun(&workers[0]);
+	
+	for ( i = 1 ; i < threads ; ++i ) {
+		if ( created[i] ) {
+			pthread_join(handles[i], NULL);
+		}
+	}
+	
+	for ( i = 0 ; i < threads ; ++i ) {
+		pthread_mutex_destroy(&workers[i].lock);
+		
+		if ( SORTING_STATISTICS && statistics ) {
+			statistics->invocations += workers[i].statistics.invocations;
+			statistics->accesses += workers[i].statistics.accesses;
+			statistics->assignments += workers[i].statistics.assignments;
+			statistics->writes += workers[i].statistics.writes;
+			statistics->comparisons += workers[i].statistics.comparisons;
+		}
+	}
+	
+	free(workers);
+}
+
+//	MARK: - Parallel Sample Sort
+
+#define kSampleMaximumBuckets 256
+#define kSampleBucketsPerThread 8
+#define kSampleOversampling 32
+
+struct SampleSort {
+	void *array;
+	void *buffer;
+	size_t count;
+	size_t size;
+	unsigned threads;
+	unsigned buckets;
+	unsigned stable;
+	unsigned nextBucket;
+	void *splitters;
+	unsigned char *oracle;
+	size_t *counts;	//	threads rows of buckets columns, counts then scatter offsets
+	size_t bucketStarts[kSampleMaximumBuckets + 1];
+	Compare *compare;
+	void *context;
+};
+
+struct SampleWorker {
+	struct SampleSort *sort;
+	unsigned index;
+	unsigned phase;
+	void *temporary;
+	struct SortingStatistics statistics;
+	struct SortingStatistics *counting;
+};
+
+enum SamplePhase {
+	kSamplePhaseClassify,
+	kSamplePhaseScatter,
+	kSamplePhaseSort
+};
+
+///	Bucket of an element is the count of splitters not greater than the element, so equal elements share a bucket
+static unsigned sampleClassify(struct SampleSort *sort, void const *element, struct SortingStatistics *statistics) {
+	unsigned m = 0, n = sort->buckets - 1, o;
+	
+	while ( m < n ) {
+		o = (m + n) / 2;
+		
+		if ( invokeIsLess(element, sort->splitters + o * sort->size, statistics, sort->compare, sort->context) ) {
+			n = o;
+		} else {
+			m = o + 1;
+		}
+	}
+	
+	return m;
+}
+
+static void *sampleWorkerRun(void *argument) {
+	struct SampleWorker *worker = argument;
+	struct SampleSort *sort = worker->sort;
+	size_t size = sort->size;
+	size_t lower = sort->count * worker->index / sort->threads;
+	size_t upper = sort->count * (worker->index + 1) / sort->threads;
+	size_t *counts = sort->counts + (size_t)worker->index * sort->buckets;
+	size_t index, start, end;
+	unsigned bucket;
+	
+	switch ( worker->phase ) {
+	case kSamplePhaseClassify:
+		for ( index = lower ; index < upper ; ++index ) {
+			bucket = sampleClassify(sort, sort->array + index * size, worker->counting);
+			sort->oracle[index] = (unsigned char)bucket;
+			counts[bucket] += 1;
+		}
+		break;
+	
+	case kSamplePhaseScatter:
+		//	each thread scatters its own chunk in order to offsets after all earlier chunks, which keeps equal elements in order
+		for ( index = lower ; index < upper ; ++index ) {
+			assignAt(sort->buffer, counts[sort->oracle[index]]++, size, sort->array + index * size, worker->counting);
+		}
+		break;
+	
+	case kSamplePhaseSort:
+		while ( (bucket = __atomic_fetch_add(&sort->nextBucket, 1, __ATOMIC_SEQ_CST)) < sort->buckets ) {
+			start = sort->bucketStarts[bucket];
+			end = sort->bucketStarts[bucket + 1];
+			
+			assignManyAt(sort->array, start, end - start, size, sort->buffer + start * size, worker->counting);
+			
+			if ( sort->stable ) {
+				coleSort(sort->array + start * size, sort->buffer + start * size, end - start, size, worker->counting, sort->compare, sort->context);
+			} else {
+				quickSort(sort->array + start * size, end - start, size, worker->temporary, worker->counting, sort->compare, sort->context);
+			}
+		}
+		break;
+	}
+	
+	return NULL;
+}
+
+static void sampleSortPhase(struct SampleWorker workers[], unsigned threads, enum SamplePhase phase) {
+	pthread_t handles[kParallelMaximumThreads];
+	unsigned created[kParallelMaximumThreads];
+	unsigned i;
+	
+	for ( i = 0 ; i < threads ; ++i ) {
+		workers[i].phase = phase;
+	}
+	
+	for ( i = 1 ; i < threads ; ++i ) {
+		created[i] = 0 == pthread_create(&handles[i], NULL, sampleWorkerRun, &workers[i]);
+	}
+	
+	sampleWorkerRun(&workers[0]);
+	
+	for ( i = 1 ; i < threads ; ++i ) {
+		if ( created[i] ) {
+			pthread_join(handles[i], NULL);
+		} else {
+			sampleWorkerRun(&workers[i]);
+		}
+	}
+}
+
+///	Sample sort that picks splitters from an oversampled and sorted sample, classifies and scatters elements into buckets in parallel, then sorts the buckets concurrently with cole sort when stable or quick sort when not
+void parallelSampleSort(void *array, void *buffer, size_t count, size_t size, unsigned threads, unsigned stable, struct SampleSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	long began = sortingMicroseconds(), ended;
+	struct SampleSortTimings ignored;
+	
+	timings = timings ? timings : &ignored;
+	memset(timings, 0, sizeof(*timings));
+	
+	threads = threads < kParallelMaximumThreads ? threads : kParallelMaximumThreads;
+	threads = count / kParallelMinimumChunk < threads ? (unsigned)(count / kParallelMinimumChunk) : threads;
+	
+	unsigned buckets = threads * kSampleBucketsPerThread < kSampleMaximumBuckets ? threads * kSampleBucketsPerThread : kSampleMaximumBuckets;
+	size_t samples = (size_t)buckets * kSampleOversampling;
+	void *splitters = threads < 2 ? NULL : malloc(samples * size);
+	unsigned char *oracle = threads < 2 ? NULL : malloc(count);
+	size_t *counts = threads < 2 ? NULL : calloc((size_t)threads * buckets, sizeof(size_t));
+	struct SampleSort sort = {array, buffer, count, size, threads, buckets, stable, 0, splitters, oracle, counts, {0}, compare, context};
+	
+	unsigned char *temporaries = threads < 2 ? NULL : malloc((size_t)threads * size);
+	
+	if ( !sort.splitters || !sort.oracle || !sort.counts || !temporaries ) {
+		free(sort.splitters);
+		free(sort.oracle);
+		free(sort.counts);
+		free(temporaries);
+		
+		if ( stable ) {
+			coleSort(array, buffer, count, size, statistics, compare, context);
+		} else {
+			balancingQuickSort(array, count, size, 0, buffer, statistics, compare, context);
+		}
+		
+		timings->sorting = sortingMicroseconds() - began;
+		return;
+	}
+	
+	struct SampleWorker workers[kParallelMaximumThreads];
+	size_t index, sum, seed = 0x9E3779B97F4A7C15ULL;
+	unsigned i, bucket;
+	
+	memset(workers, 0, sizeof(workers));
+	
+	for ( i = 0 ; i < threads ; ++i ) {
+		workers[i].sort = &sort;
+		workers[i].index = i;
+		workers[i].temporary = temporaries + (size_t)i * size;
+		workers[i].counting = SORTING_STATISTICS && statistics ? &workers[i].statistics : NULL;
+	}
+	
+	//	sample, then keep every oversampled element as a splitter at the front of the sorted sample
+	for ( index = 0 ; index < samples ; ++index ) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		assignAt(sort.splitters, index, size, array + (seed % count) * size, statistics);
+	}
+	
+	coleSort(sort.splitters, buffer, samples, size, statistics, compare, context);
+	
+	for ( i = 1 ; i < buckets ; ++i ) {
+		assignAt(sort.splitters, i - 1, size, sort.splitters + (i * kSampleOversampling) * size, statistics);
+	}
+	
+	ended = sortingMicroseconds();
+	timings->sampling = ended - began;
+	began = ended;
+	
+	sampleSortPhase(workers, threads, kSamplePhaseClassify);
+	
+	ended = sortingMicroseconds();
+	timings->classifying = ended - began;
+	began = ended;
+	
+	for ( sum = 0, bucket = 0 ; bucket < buckets ; ++bucket ) {
+		sort.bucketStarts[bucket] = sum;
+		
+		for ( i = 0 ; i < threads ; ++i ) {
+			index = sort.counts[(size_t)i * buckets + bucket];
+			sort.counts[(size_t)i * buckets + bucket] = sum;
+			sum += index;
+		}
+	}
+	
+	sort.bucketStarts[buckets] = sum;
+	
+	sampleSortPhase(workers, threads, kSamplePhaseScatter);
+	
+	ended = sortingMicroseconds();
+	timings->scattering = ended - began;
+	began = ended;
+	
+	sampleSortPhase(workers, threads, kSamplePhaseSort);
+	
+	ended = sortingMicroseconds();
+	timings->sorting = ended - began;
+	
+	free(sort.splitters);
+	free(sort.oracle);
+	free(sort.counts);
+	free(temporaries);
+	
+	if ( SORTING_STATISTICS && statistics ) {
+		for ( i = 0 ; i < threads ; ++i ) {
+			statistics->invocations += workers[i].statistics.invocations;
+			statistics->accesses += workers[i].statistics.accesses;
+			statistics->assignments += workers[i].statistics.assignments;
+			statistics->writes += workers[i].statistics.writes;
+			statistics->comparisons += workers[i].statistics.comparisons;
+		}
+	}
+}
+
+//	MARK: - Radix Sort
+
+#define kRadixBits 8
+#define kRadixDigits (1 << kRadixBits)
+#define kRadixMaximumPasses 8
+
+static inline uint64_t radixKeyAt(void const *element, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics, RadixKey key, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->accesses += 1;
+	}
+	
+	if ( key ) {
+		return key(element, context);
+	}
+	
+	uint8_t k1;
+	uint16_t k2;
+	uint32_t k4;
+	uint64_t k8;
+	
+	switch ( keyWidth ) {
+	case 1: memcpy(&k1, element + keyOffset, 1); return k1;
+	case 2: memcpy(&k2, element + keyOffset, 2); return k2;
+	case 4: memcpy(&k4, element + keyOffset, 4); return k4;
+	case 8: memcpy(&k8, element + keyOffset, 8); return k8;
+	}
+	
+	//	other widths have no native integer, so only the key bytes are read as little endian
+	k8 = 0;
+	memcpy(&k8, element + keyOffset, keyWidth);
+	
+	return k8;
+}
+
+static void radixSortPasses(void *array, void *buffer, size_t count, size_t size, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics, RadixKey key, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t histograms[kRadixMaximumPasses][kRadixDigits] = {};
+	size_t index, digit, sum, total;
+	unsigned pass, passes = (unsigned)keyWidth;
+	uint64_t k, first = radixKeyAt(array, keyOffset, keyWidth, statistics, key, context);
+	void *unsorted = array, *sorted = buffer, *swap;
+	
+	//	one pass over the keys counts the digits of every pass
+	for ( index = 0 ; index < count ; ++index ) {
+		k = radixKeyAt(array + index * size, keyOffset, keyWidth, statistics, key, context);
+		
+		for ( pass = 0 ; pass < passes ; ++pass ) {
+			histograms[pass][(k >> (pass * kRadixBits)) & (kRadixDigits - 1)] += 1;
+		}
+	}
+	
+	for ( pass = 0 ; pass < passes ; ++pass ) {
+		size_t *histogram = histograms[pass];
+		
+		//	every key has the same digit, so the pass would not change the order
+		if ( histogram[(first >> (pass * kRadixBits)) & (kRadixDigits - 1)] == count ) {
+			continue;
+		}
+		
+		for ( sum = 0, digit = 0 ; digit < kRadixDigits ; ++digit ) {
+			total = histogram[digit];
+			histogram[digit] = sum;
+			sum += total;
+		}
+		
+		for ( index = 0 ; index < count ; ++index ) {
+			k = radixKeyAt(unsorted + index * size, keyOffset, keyWidth, statistics, key, context);
+			digit = (k >> (pass * kRadixBits)) & (kRadixDigits - 1);
+			
+			assignAt(sorted, histogram[digit]++, size, unsorted + index * size, statistics);
+		}
+		
+		swap = unsorted;
+		unsorted = sorted;
+		sorted = swap;
+	}
+	
+	if ( unsorted != array ) {
+		assignManyAt(array, 0, count, size, unsorted, statistics);
+	}
+}
+
+///	Stable least significant digit radix sort of elements with an unsigned integer key of 1 to 8 bytes at an offset within each element, native for 1, 2, 4, or 8 bytes and little endian otherwise
+void radixSort(void *array, void *buffer, size_t count, size_t size, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	keyWidth = keyWidth < kRadixMaximumPasses ? keyWidth : kRadixMaximumPasses;
+	
+	switch ( size ) {
+	case 4: radixSortPasses(array, buffer, count, 4, keyOffset, keyWidth, statistics, NULL, NULL); break;
+	case 8: radixSortPasses(array, buffer, count, 8, keyOffset, keyWidth, statistics, NULL, NULL); break;
+	case 16: radixSortPasses(array, buffer, count, 16, keyOffset, keyWidth, statistics, NULL, NULL); break;
+	default: radixSortPasses(array, buffer, count, size, keyOffset, keyWidth, statistics, NULL, NULL); break;
+	}
+}
+
+///	Stable least significant digit radix sort ordered by the unsigned integer key returned for each element, where only the low keyWidth bytes of each key are significant
+void radixKeySort(void *array, void *buffer, size_t count, size_t size, size_t keyWidth, struct SortingStatistics *statistics, RadixKey key, void *context) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	keyWidth = keyWidth < kRadixMaximumPasses ? keyWidth : kRadixMaximumPasses;
+	
+	switch ( size ) {
+	case 4: radixSortPasses(array, buffer, count, 4, 0, keyWidth, statistics, key, context); break;
+	case 8: radixSortPasses(array, buffer, count, 8, 0, keyWidth, statistics, key, context); break;
+	case 16: radixSortPasses(array, buffer, count, 16, 0, keyWidth, statistics, key, context); break;
+	default: radixSortPasses(array, buffer, count, size, 0, keyWidth, statistics, key, context); break;
+	}
+}
+
+//	MARK: - String Sort
+
+#define kStringRadixMinimum 64
+
+static signed compareStringFrom(void const *a, void const *b, void *context) {
+	size_t depth = *(size_t const *)context;
+	
+	return strcmp(*(char * const *)a + depth, *(char * const *)b + depth);
+}
+
+static void stringRadixSort(char **array, char **buffer, size_t count, size_t depth, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t histogram[256];
+	size_t index, start, sum, total;
+	unsigned c, first;
+	
+	while ( count >= kStringRadixMinimum ) {
+		memset(histogram, 0, sizeof(histogram));
+		
+		for ( index = 0 ; index < count ; ++index ) {
+			histogram[(unsigned char)array[index][depth]] += 1;
+		}
+		
+		if ( SORTING_STATISTICS && statistics ) {
+			statistics->accesses += count;
+		}
+		
+		first = (unsigned char)array[0][depth];
+		
+		//	a shared character moves nothing, so continue with the next character of the same strings
+		if ( histogram[first] == count ) {
+			if ( first == 0 ) {
+				return;
+			}
+			
+			depth += 1;
+			continue;
+		}
+		
+		for ( sum = 0, c = 0 ; c < 256 ; ++c ) {
+			total = histogram[c];
+			histogram[c] = sum;
+			sum += total;
+		}
+		
+		for ( index = 0 ; index < count ; ++index ) {
+			assignAt(buffer, histogram[(unsigned char)array[index][depth]]++, sizeof(char *), &array[index], statistics);
+		}
+		
+		assignManyAt(array, 0, count, sizeof(char *), buffer, statistics);
+		
+		//	strings that end at this depth are equal and already in order
+		for ( start = histogram[0], c = 1 ; c < 256 ; ++c ) {
+			if ( histogram[c] - start > 1 ) {
+				stringRadixSort(array + start, buffer + start, histogram[c] - start, depth + 1, statistics);
+			}
+			
+			start = histogram[c];
+		}
+		
+		return;
+	}
+	
+	coleSort(array, buffer, count, sizeof(char *), statistics, compareStringFrom, &depth);
+}
+
+///	Stable most significant digit radix sort of C strings that reads each character position once, sorting small buckets with cole sort from the current character
+void stringSort(char **array, char **buffer, size_t count, struct SortingStatistics *statistics) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	stringRadixSort(array, buffer, count, 0, statistics);
+}
+
+struct StringPrefix {
+	uint64_t prefix;
+	char *string;
+};
+
+struct StringPrefixContext {
+	Compare *compare;
+	void *context;
+};
+
+static uint64_t stringPrefixKey(void const *element, void *context) {
+	return ((struct StringPrefix const *)element)->prefix;
+}
+
+static signed compareStringPrefixTie(void const *a, void const *b, void *context) {
+	struct StringPrefixContext const *tie = context;
+	
+	return tie->compare(&((struct StringPrefix const *)a)->string, &((struct StringPrefix const *)b)->string, tie->context);
+}
+
+///	Stable sort of C strings that radix sorts cached 8 byte big endian keys taken after the prefix common to every string, calling compare only to order strings with equal keys
+void stringPrefixSort(char **array, void *buffer, size_t count, struct SortingStatistics *statistics, Compare compare, void *context) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	if ( count < 2 ) {
+		return;
+	}
+	
+	struct StringPrefix *prefixes = buffer;
+	struct StringPrefixContext tie = {compare, context};
+	size_t index, start, common = strlen(array[0]), depth;
+	uint64_t prefix;
+	char const *s;
 	
-	size_t pivot = count / 2;
-	size_t lower = 0, upper = count - 1;
+	//	the common prefix and the cached keys agree with compare because it orders strings by unsigned bytes like strcmp
+	for ( index = 1 ; index < count && common > 0 ; ++index ) {
+		for ( depth = 0 ; depth < common && array[index][depth] == array[0][depth] ; ++depth ) {}
+		
+		common = depth;
+	}
 	
-	if ( invokeIsLess(array + pivot * size, array + lower * size, statistics, compare, context) ) {
-		swapAt(array, pivot, lower, size, temporary, statistics);
+	for ( index = 0 ; index < count ; ++index ) {
+		s = array[index] + common;
+		
+		for ( prefix = 0, depth = 0 ; depth < 8 ; ++depth ) {
+			prefix = prefix << 8 | (unsigned char)s[depth];
+			
+			if ( !s[depth] ) {
+				prefix <<= 8 * (7 - depth);
+				break;
+			}
+		}
+		
+		prefixes[index].prefix = prefix;
+		prefixes[index].string = array[index];
 	}
 	
-	if ( invokeIsLess(array + upper * size, array + pivot * size, statistics, compare, context) ) {
-		swapAt(array, pivot, upper, size, temporary, statistics);
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->accesses += count;
+	}
+	
+	radixKeySort(prefixes, prefixes + count, count, sizeof(struct StringPrefix), 8, statistics, stringPrefixKey, NULL);
+	
+	//	keys with a zero last byte hold the whole string, so only longer strings with equal keys need the comparator
+	for ( start = 0, index = 1 ; index <= count ; ++index ) {
+		if ( index < count && prefixes[index].prefix == prefixes[start].prefix ) {
+			continue;
+		}
 		
-		if ( invokeIsLess(array + pivot * size, array + lower * size, statistics, compare, context) ) {
-			swapAt(array, pivot, lower, size, temporary, statistics);
+		if ( index - start > 1 && (prefixes[start].prefix & 0xFF) ) {
+			coleSort(prefixes + start, prefixes + count, index - start, sizeof(struct StringPrefix), statistics, compareStringPrefixTie, &tie);
 		}
+		
+		start = index;
 	}
 	
-	for ( ;; ) {
-		do {
-			lower += 1;
-		} while ( invokeIsLess(array + lower * size, array + pivot * size, statistics, compare, context) );
+	for ( index = 0 ; index < count ; ++index ) {
+		assignAt(array, index, sizeof(char *), &prefixes[index].string, statistics);
+	}
+}
+
+//	MARK: - Argsort
+
+struct Argsort {
+	void const *array;
+	size_t size;
+	size_t keyOffset;
+	size_t keyWidth;
+	Compare *compare;
+	void *context;
+};
+
+static inline size_t argsortIndexAt(void const *indices, size_t at, size_t indexSize) {
+	return indexSize == sizeof(uint32_t) ? ((uint32_t const *)indices)[at] : ((size_t const *)indices)[at];
+}
+
+static inline void argsortIndexSet(void *indices, size_t at, size_t indexSize, size_t index) {
+	if ( indexSize == sizeof(uint32_t) ) {
+		((uint32_t *)indices)[at] = (uint32_t)index;
+	} else {
+		((size_t *)indices)[at] = index;
+	}
+}
+
+static void argsortIdentity(void *indices, size_t count, size_t indexSize) {
+	size_t index;
+	
+	if ( indexSize == sizeof(uint32_t) ) {
+		for ( index = 0 ; index < count ; ++index ) { ((uint32_t *)indices)[index] = (uint32_t)index; }
+	} else {
+		for ( index = 0 ; index < count ; ++index ) { ((size_t *)indices)[index] = index; }
+	}
+}
+
+static signed compareArgsort32(void const *a, void const *b, void *context) {
+	struct Argsort const *argsort = context;
+	
+	return argsort->compare(argsort->array + *(uint32_t const *)a * argsort->size, argsort->array + *(uint32_t const *)b * argsort->size, argsort->context);
+}
+
+static signed compareArgsort64(void const *a, void const *b, void *context) {
+	struct Argsort const *argsort = context;
+	
+	return argsort->compare(argsort->array + *(size_t const *)a * argsort->size, argsort->array + *(size_t const *)b * argsort->size, argsort->context);
+}
+
+///	Equal records are ordered by index so an unstable sort of the indices still produces a stable permutation
+static signed compareArgsortIndex32(void const *a, void const *b, void *context) {
+	signed c = compareArgsort32(a, b, context);
+	
+	return c ? c : (*(uint32_t const *)a > *(uint32_t const *)b) - (*(uint32_t const *)a < *(uint32_t const *)b);
+}
+
+static signed compareArgsortIndex64(void const *a, void const *b, void *context) {
+	signed c = compareArgsort64(a, b, context);
+	
+	return c ? c : (*(size_t const *)a > *(size_t const *)b) - (*(size_t const *)a < *(size_t const *)b);
+}
+
+static uint64_t radixKeyArgsort32(void const *element, void *context) {
+	struct Argsort const *argsort = context;
+	
+	return radixKeyAt(argsort->array + *(uint32_t const *)element * argsort->size, argsort->keyOffset, argsort->keyWidth, NULL, NULL, NULL);
+}
+
+static uint64_t radixKeyArgsort64(void const *element, void *context) {
+	struct Argsort const *argsort = context;
+	
+	return radixKeyAt(argsort->array + *(size_t const *)element * argsort->size, argsort->keyOffset, argsort->keyWidth, NULL, NULL, NULL);
+}
+
+///	Stable cole sort of an index permutation, indices holds count uint32_t or size_t as given by indexSize and buffer the same, the records are not moved
+void coleArgsort(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context) {
+	struct Argsort argsort = {array, size, 0, 0, compare, context};
+	
+	argsortIdentity(indices, count, indexSize);
+	coleSort(indices, buffer, count, indexSize, statistics, indexSize == sizeof(uint32_t) ? compareArgsort32 : compareArgsort64, &argsort);
+}
+
+///	Quick sort of an index permutation, ties are broken by index so the permutation is stable
+void quickArgsort(void const *array, void *indices, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context) {
+	struct Argsort argsort = {array, size, 0, 0, compare, context};
+	size_t temporary;
+	
+	argsortIdentity(indices, count, indexSize);
+	quickSort(indices, count, indexSize, &temporary, statistics, indexSize == sizeof(uint32_t) ? compareArgsortIndex32 : compareArgsortIndex64, &argsort);
+}
+
+///	Stable radix sort of an index permutation by the unsigned integer key of 1 to 8 bytes at an offset within each record, read as by radixSort
+void radixArgsort(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics) {
+	keyWidth = keyWidth < kRadixMaximumPasses ? keyWidth : kRadixMaximumPasses;
+	
+	struct Argsort argsort = {array, size, keyOffset, keyWidth, NULL, NULL};
+	
+	argsortIdentity(indices, count, indexSize);
+	radixKeySort(indices, buffer, count, indexSize, keyWidth, statistics, indexSize == sizeof(uint32_t) ? radixKeyArgsort32 : radixKeyArgsort64, &argsort);
+}
+
+///	Reorder records so array[i] becomes the record that was at array[indices[i]], following each cycle so every record moves once, indices are left as the identity
+void applyPermutation(void *array, void *indices, size_t count, size_t size, size_t indexSize, void *temporary, struct SortingStatistics *statistics) {
+	if ( SORTING_STATISTICS && statistics ) {
+		statistics->invocations += 1;
+	}
+	
+	size_t start, at, from;
+	
+	for ( start = 0 ; start < count ; ++start ) {
+		if ( argsortIndexAt(indices, start, indexSize) == start ) {
+			continue;
+		}
 		
-		do {
-			upper -= 1;
-		} while ( invokeIsLess(array + pivot * size, array + upper * size, statistics, compare, context) );
+		assignAt(temporary, 0, size, array + start * size, statistics);
 		
-		if ( lower < upper ) {
-			swapAt(array, lower, upper, size, temporary, statistics);
-			
-			if ( pivot == lower ) {
-				pivot = upper;
-			} else if ( pivot == upper ) {
-				pivot = lower;
-			}
-		} else {
-			break;
+		for ( at = start ; (from = argsortIndexAt(indices, at, indexSize)) != start ; at = from ) {
+			assignAt(array, at, size, array + from * size, statistics);
+			argsortIndexSet(indices, at, indexSize, at);
 		}
+		
+		assignAt(array, at, size, temporary, statistics);
+		argsortIndexSet(indices, at, indexSize, at);
+	}
+}
+
+//	MARK: - Payload Sort
+
+///	Apply the same sorted permutation to every payload and then to the keys, buffer holds a copy of the indices for each payload since applying consumes them
+static void payloadPermute(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics) {
+	unsigned payload;
+	
+	for ( payload = 0 ; payload < payloadCount ; ++payload ) {
+		memcpy(buffer, indices, count * indexSize);
+		applyPermutation(payloads[payload].array, buffer, count, payloads[payload].size, indexSize, temporary, statistics);
 	}
 	
-	return 1 + upper;
+	applyPermutation(keys, indices, count, size, indexSize, temporary, statistics);
 }
 
-///	Quick sort identifies a pivot element then swaps elements on the wrong side of the pivot
-void quickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+///	Stable cole sort of a key array that moves each payload array, with its own element size, exactly as the keys move, indices and buffer each hold count uint32_t or size_t as given by indexSize and temporary holds the largest key or payload element
+void coleSortPayloads(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
 	if ( count < 2 ) {
 		return;
-	} else if ( count < 16 ) {
-		binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
-	} else {
-		size_t pivot = quickPartition(array, count, size, temporary, statistics, compare, context);
-		
-		quickSort(array, pivot, size, temporary, statistics, compare, context);
-		quickSort(array + pivot * size, count - pivot, size, temporary, statistics, compare, context);
 	}
+	
+	coleArgsort(keys, indices, buffer, count, size, indexSize, statistics, compare, context);
+	payloadPermute(keys, indices, buffer, count, size, indexSize, payloads, payloadCount, temporary, statistics);
 }
 
-/// Self balancing quick sort that use an alternate sorting algorithm on affected regions after several pivots in a row are imbalanced
-void balancingQuickSort(void *array, size_t count, size_t size, unsigned imbalances, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context) {
+///	Stable radix sort of a key array by the unsigned integer key of 1 to 8 bytes at an offset within each key element, read as by radixSort, moving each payload array exactly as the keys move, with the same indices, buffer, and temporary as coleSortPayloads
+void radixSortPayloads(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics) {
 	if ( count < 2 ) {
 		return;
-	} else if ( count < 16 ) {	//	higher threshold will decrease comparisons and increase assignments
-		binaryInsertionSort(array, count, size, 1, temporary, statistics, compare, context);
-	} else if ( imbalances > 4 ) {
-		heapSort(array, count, size, temporary, statistics, compare, context);
-	} else {
-		size_t pivot = quickPartition(array, count, size, temporary, statistics, compare, context);
-		size_t ratio = 12;
+	}
+	
+	radixArgsort(keys, indices, buffer, count, size, indexSize, keyOffset, keyWidth, statistics);
+	payloadPermute(keys, indices, buffer, count, size, indexSize, payloads, payloadCount, temporary, statistics);
+}
+
+//	MARK: - External Sort
+
+#define kExternalMinimumBlock 65536
+#define kExternalMaximumFanIn 64
+
+///	A sorted run at an offset in the shared temporary file of runs, read one block at a time
+struct ExternalRun {
+	off_t offset;
+	void *block;
+	size_t remaining;
+	size_t index;
+	size_t filled;
+};
+
+///	Temporary file in directory, or from tmpfile when directory is null, unlinked while open so nothing outlives the sort
+static FILE *externalTemporaryFile(char const *directory) {
+	if ( !directory ) {
+		return tmpfile();
+	}
+	
+	size_t length = strlen(directory);
+	char *path = malloc(length + 16);
+	FILE *file = NULL;
+	
+	if ( !path ) {
+		return NULL;
+	}
+	
+	memcpy(path, directory, length);
+	memcpy(path + length, "/scortchXXXXXX", 15);
+	
+	int descriptor = mkstemp(path);
+	
+	if ( descriptor >= 0 ) {
+		unlink(path);
+		file = fdopen(descriptor, "w+b");
 		
-		imbalances = count > ratio * (count - pivot - 1 < pivot ? count - pivot - 1 : pivot) ? imbalances + 1 : 0;
+		if ( !file ) {
+			close(descriptor);
+		}
+	}
+	
+	free(path);
+	
+	return file;
+}
+
+///	Read the next block of a run from the file of runs, returns zero on a read error
+static unsigned externalRunFill(struct ExternalRun *run, FILE *file, size_t blockCount, size_t size, long *bytesRead) {
+	size_t wanted = run->remaining < blockCount ? run->remaining : blockCount;
+	size_t read = fseeko(file, run->offset, SEEK_SET) ? 0 : fread(run->block, size, wanted, file);
+	
+	run->offset += read * size;
+	run->remaining -= read;
+	run->index = 0;
+	run->filled = read;
+	*bytesRead += read * size;
+	
+	return read == wanted;
+}
+
+///	Stream a stable k-way merge of sorted runs from input into output through one block per run and one output block, all carved from space
+static int externalMerge(struct ExternalRun *runs, unsigned runCount, FILE *input, FILE *output, void *space, size_t blockCount, size_t size, long *bytesRead, long *bytesWritten, struct SortingStatistics *statistics, Compare compare, void *context) {
+	struct ExternalRun *order[kExternalMaximumFanIn];
+	void *merged = space + runCount * blockCount * size;
+	size_t count = 0, streak = 0, take;
+	unsigned valid = 0, i, m, n, o;
+	
+	//	blocks are carved in run order so the address tie break of invokeStableIsLess keeps earlier runs first among equal heads
+	for ( i = 0 ; i < runCount ; ++i ) {
+		runs[i].block = space + i * blockCount * size;
 		
-		balancingQuickSort(array, pivot, size, imbalances, temporary, statistics, compare, context);
-		balancingQuickSort(array + pivot * size, count - pivot, size, imbalances, temporary, statistics, compare, context);
+		if ( !externalRunFill(&runs[i], input, blockCount, size, bytesRead) ) {
+			return -1;
+		}
+		
+		if ( !runs[i].filled ) {
+			continue;
+		}
+		
+		for ( m = 0, n = valid ; m < n ; ) {
+			o = (m + n) / 2;
+			
+			if ( invokeStableIsLess(runs[i].block, order[o]->block + order[o]->index * size, statistics, compare, context) ) {
+				n = o;
+			} else {
+				m = o + 1;
+			}
+		}
+		
+		memmove(order + m + 1, order + m, (valid - m) * sizeof *order);
+		order[m] = &runs[i];
+		valid += 1;
+	}
+	
+	while ( valid ) {
+		struct ExternalRun *lead = order[0];
+		void const *head = lead->block + lead->index * size;
+		size_t available = lead->filled - lead->index;
+		
+		//	the last run or a long streak from the lead moves a whole stretch at once
+		if ( valid == 1 ) {
+			take = available;
+		} else if ( streak >= kGallopMinimum ) {
+			take = gallopCount(order[1]->block + order[1]->index * size, head, available, size, lead < order[1], statistics, compare, context);
+		} else {
+			take = 1;
+		}
+		
+		take = take < blockCount - count ? take : blockCount - count;
+		take = take ? take : 1;
+		assignManyAt(merged, count, take, size, head, statistics);
+		count += take;
+		lead->index += take;
+		streak += 1;
+		
+		if ( count == blockCount ) {
+			if ( fwrite(merged, size, count, output) != count ) {
+				return -1;
+			}
+			
+			*bytesWritten += count * size;
+			count = 0;
+		}
+		
+		if ( lead->index == lead->filled ) {
+			if ( !lead->remaining ) {
+				memmove(order, order + 1, --valid * sizeof *order);
+				streak = 0;
+				continue;
+			} else if ( !externalRunFill(lead, input, blockCount, size, bytesRead) ) {
+				return -1;
+			}
+		}
+		
+		if ( valid < 2 || invokeStableIsLess(lead->block + lead->index * size, order[1]->block + order[1]->index * size, statistics, compare, context) ) {
+			continue;
+		}
+		
+		for ( m = 2, n = valid ; m < n ; ) {
+			o = (m + n) / 2;
+			
+			if ( invokeStableIsLess(lead->block + lead->index * size, order[o]->block + order[o]->index * size, statistics, compare, context) ) {
+				n = o;
+			} else {
+				m = o + 1;
+			}
+		}
+		
+		memmove(order, order + 1, (m - 1) * sizeof *order);
+		order[m - 1] = lead;
+		streak = 0;
+	}
+	
+	if ( count ) {
+		if ( fwrite(merged, size, count, output) != count ) {
+			return -1;
+		}
+		
+		*bytesWritten += count * size;
+	}
+	
+	return 0;
+}
+
+///	Read memory sized chunks of input and coleSort each into a run appended to one temporary file, or straight into output when the input fits in one chunk
+static int externalFormRuns(FILE *input, char const *outputPath, FILE **output, FILE **runsFile, char const *temporaryDirectory, void *space, size_t chunk, size_t size, struct ExternalRun **runs, unsigned *runCount, struct ExternalSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context) {
+	unsigned capacity = 0;
+	size_t read, count;
+	off_t offset = 0;
+	FILE *file;
+	long began;
+	int c;
+	
+	while ( (read = fread(space, 1, chunk * size, input)) ) {
+		if ( read % size ) {
+			errno = EINVAL;
+			return -1;
+		}
+		
+		count = read / size;
+		timings->formingBytesRead += read;
+		began = sortingMicroseconds();
+		coleSort(space, space + chunk * size, count, size, statistics, compare, context);
+		timings->sorting += sortingMicroseconds() - began;
+		
+		if ( !*runCount && (c = fgetc(input)) == EOF ) {
+			file = *output = fopen(outputPath, "wb");
+		} else {
+			if ( !*runCount ) {
+				ungetc(c, input);
+				*runsFile = externalTemporaryFile(temporaryDirectory);
+			}
+			
+			file = *runsFile;
+			
+			if ( file && *runCount == capacity ) {
+				struct ExternalRun *more = realloc(*runs, (capacity = capacity ? capacity * 2 : 16) * sizeof **runs);
+				
+				if ( !more ) {
+					return -1;
+				}
+				
+				*runs = more;
+			}
+			
+			if ( file ) {
+				(*runs)[*runCount].offset = offset;
+				(*runs)[*runCount].remaining = count;
+				*runCount += 1;
+				offset += read;
+			}
+		}
+		
+		if ( !file || fwrite(space, size, count, file) != count ) {
+			return -1;
+		}
+		
+		timings->formingBytesWritten += read;
+	}
+	
+	return ferror(input) ? -1 : 0;
+}
+
+///	Merge groups of runs in order into longer runs in a second temporary file, swapping the two files after each pass, until one last pass can merge them all into output
+static int externalMergeRuns(struct ExternalRun *runs, unsigned runCount, unsigned fanIn, FILE **runsFile, FILE **passFile, FILE *output, char const *temporaryDirectory, void *space, size_t memory, size_t size, struct ExternalSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context) {
+	unsigned i, j, group, merged;
+	size_t blockCount, count;
+	off_t offset;
+	FILE *file;
+	
+	for ( ;; ) {
+		if ( runCount <= fanIn ) {
+			file = output;
+		} else {
+			if ( !*passFile ) {
+				*passFile = externalTemporaryFile(temporaryDirectory);
+			}
+			
+			file = *passFile;
+			
+			if ( !file || fseeko(file, 0, SEEK_SET) ) {
+				return -1;
+			}
+		}
+		
+		for ( i = 0, merged = 0, offset = 0 ; i < runCount ; i += group ) {
+			group = runCount - i < fanIn ? runCount - i : fanIn;
+			
+			for ( j = 0, count = 0 ; j < group ; ++j ) {
+				count += runs[i + j].remaining;
+			}
+			
+			blockCount = memory / (group + 1) / size;
+			blockCount = blockCount ? blockCount : 1;
+			
+			if ( externalMerge(runs + i, group, *runsFile, file, space, blockCount, size, &timings->mergingBytesRead, &timings->mergingBytesWritten, statistics, compare, context) ) {
+				return -1;
+			}
+			
+			runs[merged].offset = offset;
+			runs[merged].remaining = count;
+			merged += 1;
+			offset += count * size;
+		}
+		
+		timings->passes += 1;
+		
+		if ( file == output ) {
+			return 0;
+		}
+		
+		runCount = merged;
+		*passFile = *runsFile;
+		*runsFile = file;
+	}
+}
+
+///	Stable sort of a file of fixed size records larger than memory, coleSort each memory sized chunk into a temporary run then stream k-way merges of the runs into output, with at most three files open at once, returns zero or -1 with errno set
+int externalSort(char const *inputPath, char const *outputPath, char const *temporaryDirectory, size_t size, size_t memory, struct ExternalSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context) {
+	struct ExternalSortTimings ignored;
+	struct ExternalRun *runs = NULL;
+	unsigned runCount = 0, fanIn;
+	size_t chunk = size ? memory / size / 2 : 0;
+	FILE *input, *output = NULL, *runsFile = NULL, *passFile = NULL;
+	void *space;
+	int result = -1, error;
+	long began;
+	
+	timings = timings ? timings : &ignored;
+	memset(timings, 0, sizeof *timings);
+	
+	//	the chunk and the coleSort buffer share the memory budget while forming runs
+	if ( !chunk ) {
+		errno = EINVAL;
+		return -1;
+	}
+	
+	fanIn = memory < 3 * kExternalMinimumBlock ? 2 : (unsigned)(memory / kExternalMinimumBlock) - 1;
+	fanIn = fanIn < kExternalMaximumFanIn ? fanIn : kExternalMaximumFanIn;
+	space = malloc(memory > size * (fanIn + 1) ? memory : size * (fanIn + 1));
+	input = fopen(inputPath, "rb");
+	
+	if ( space && input ) {
+		began = sortingMicroseconds();
+		result = externalFormRuns(input, outputPath, &output, &runsFile, temporaryDirectory, space, chunk, size, &runs, &runCount, timings, statistics, compare, context);
+		//	input that fits in one chunk is sorted straight into output as its only run
+		timings->runs = output ? 1 : runCount;
+		timings->forming = sortingMicroseconds() - began;
+		fclose(input);
+		input = NULL;
+		
+		//	output is only opened once the input has been read, so the two may be the same file
+		if ( !result && !output ) {
+			output = fopen(outputPath, "wb");
+			result = output ? 0 : -1;
+		}
+		
+		if ( !result && runCount ) {
+			began = sortingMicroseconds();
+			result = externalMergeRuns(runs, runCount, fanIn, &runsFile, &passFile, output, temporaryDirectory, space, memory, size, timings, statistics, compare, context);
+			timings->merging = sortingMicroseconds() - began;
+		}
+	}
+	
+	error = errno;
+	
+	if ( output && fclose(output) && !result ) {
+		error = errno;
+		result = -1;
 	}
+	
+	if ( input ) {
+		fclose(input);
+	}
+	
+	if ( runsFile ) {
+		fclose(runsFile);
+	}
+	
+	if ( passFile ) {
+		fclose(passFile);
+	}
+	
+	free(runs);
+	free(space);
+	errno = error;
+	
+	return result;
 }
@@ -9,8 +9,11 @@
 #ifndef sort_h
 #define sort_h
 
+#include <stdint.h>
+
 typedef unsigned IsLess(void const *, void const *, void *);
 typedef signed Compare(void const *, void const *, void *);
+typedef uint64_t RadixKey(void const *, void *);
 
 struct SortingStatistics {
 	long invocations;
@@ -23,6 +26,36 @@ struct SortingStatistics {
 	long timerEnded;
 };
 
+///	An array sorted alongside the keys, moved exactly as the keys are moved
+struct SortingPayload {
+	void *array;
+	size_t size;
+};
+
+///	Bytes of buffer stringPrefixSort needs for each string, room for a cached key and string pointer in the array and the radix buffer
+#define kStringPrefixBufferSize (4 * sizeof(uint64_t))
+
+///	Microseconds spent in each phase of parallelSampleSort
+struct SampleSortTimings {
+	long sampling;
+	long classifying;
+	long scattering;
+	long sorting;
+};
+
+///	Microseconds and bytes moved in each phase of externalSort, sorting is the part of forming spent in coleSort
+struct ExternalSortTimings {
+	long runs;
+	long passes;
+	long forming;
+	long sorting;
+	long merging;
+	long formingBytesRead;
+	long formingBytesWritten;
+	long mergingBytesRead;
+	long mergingBytesWritten;
+};
+
 void reverse(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics);
 
 void binaryInsertionSort(void *array, size_t count, size_t size, size_t sorted, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
@@ -38,6 +71,12 @@ void mergeFourSort(void *array, void *buffer, size_t count, size_t size, struct
 void bottomUpMergeFourSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
 
 void coleSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void halfColeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void powerColeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void coleSortAppended(void *array, void *buffer, size_t count, size_t size, size_t sorted, struct SortingStatistics *statistics, Compare compare, void *context);
+void blockMergeSort(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelColeSort(void *array, void *buffer, size_t count, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelMergeSorted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context);
 
 void tumbleMergeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
 void polymergeSort(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
@@ -47,5 +86,103 @@ void juggleMergeSort(void *array, void *buffer, size_t count, size_t size, unsig
 void heapSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
 void quickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
 void balancingQuickSort(void *array, size_t count, size_t size, unsigned imbalances, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void patternDefeatingQuickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void threeWayQuickSort(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void partialSort(void *array, size_t count, size_t k, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickSelect(void *array, size_t count, size_t nth, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+///	nths must be ascending, each side of a partition continues with a contiguous run of them
+void quickMultiSelect(void *array, size_t count, size_t const *nths, size_t nthCount, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelBalancingQuickSort(void *array, size_t count, size_t size, unsigned imbalances, unsigned threads, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void parallelSampleSort(void *array, void *buffer, size_t count, size_t size, unsigned threads, unsigned stable, struct SampleSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void radixSort(void *array, void *buffer, size_t count, size_t size, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics);
+void radixKeySort(void *array, void *buffer, size_t count, size_t size, size_t keyWidth, struct SortingStatistics *statistics, RadixKey key, void *context);
+void stringSort(char **array, char **buffer, size_t count, struct SortingStatistics *statistics);
+///	Buffer holds count * kStringPrefixBufferSize bytes aligned like malloc for the cached keys, compare must order strings by unsigned bytes like strcmp
+void stringPrefixSort(char **array, void *buffer, size_t count, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void coleArgsort(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickArgsort(void const *array, void *indices, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context);
+void radixArgsort(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics);
+void applyPermutation(void *array, void *indices, size_t count, size_t size, size_t indexSize, void *temporary, struct SortingStatistics *statistics);
+void coleSortPayloads(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void radixSortPayloads(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics);
+
+int externalSort(char const *inputPath, char const *outputPath, char const *temporaryDirectory, size_t size, size_t memory, struct ExternalSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context);
+
+//	MARK: - Sorting Network
+
+//	Compare functions for primitive keys.  Floats use a total order with -0 before +0 and NaN beyond infinity.
+//	The sorts recognize these functions and build their initial blocks with vector sorting networks.
+
+signed compareInt32(void const *a, void const *b, void *context);
+signed compareUInt32(void const *a, void const *b, void *context);
+signed compareFloat32(void const *a, void const *b, void *context);
+signed compareInt64(void const *a, void const *b, void *context);
+signed compareUInt64(void const *a, void const *b, void *context);
+signed compareFloat64(void const *a, void const *b, void *context);
+
+size_t networkSortWidth(size_t size, Compare compare);
+size_t networkSort(void const *unsorted, void *sorted, size_t count, size_t size, Compare compare);
+size_t networkMerge(void const *unmerged, void *merged, size_t count, size_t split, size_t size, Compare compare);
+size_t networkMergeRuns(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, size_t size, Compare compare);
+
+//	MARK: - Uncounted
+
+//	The same algorithms compiled without statistics.  The statistics parameter is ignored.
+
+void reverseUncounted(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics);
+
+void binaryInsertionSortUncounted(void *array, size_t count, size_t size, size_t sorted, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void binaryMoveSortUncounted(void *unsorted, void *sorted, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void mergeSortUncounted(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+void insertionMergeSortUncounted(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+void bottomUpMergeSortUncounted(void *array, size_t count, size_t size, size_t width, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void seriesMergeSortUncounted(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void mergeFourSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void bottomUpMergeFourSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void coleSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void halfColeSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void powerColeSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void coleSortAppendedUncounted(void *array, void *buffer, size_t count, size_t size, size_t sorted, struct SortingStatistics *statistics, Compare compare, void *context);
+void blockMergeSortUncounted(void *array, size_t count, size_t size, void *buffer, size_t space, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelColeSortUncounted(void *array, void *buffer, size_t count, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelMergeSortedUncounted(void const *unmerged, void *merged, size_t count, size_t split, size_t size, unsigned threads, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void tumbleMergeSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void polymergeSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void bottomUpPolymergeSortUncounted(void *array, void *buffer, size_t count, size_t size, struct SortingStatistics *statistics, Compare compare, void *context);
+void juggleMergeSortUncounted(void *array, void *buffer, size_t count, size_t size, unsigned juggling, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void heapSortUncounted(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickSortUncounted(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void balancingQuickSortUncounted(void *array, size_t count, size_t size, unsigned imbalances, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void patternDefeatingQuickSortUncounted(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void threeWayQuickSortUncounted(void *array, size_t count, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void partialSortUncounted(void *array, size_t count, size_t k, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickSelectUncounted(void *array, size_t count, size_t nth, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickMultiSelectUncounted(void *array, size_t count, size_t const *nths, size_t nthCount, size_t size, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void parallelBalancingQuickSortUncounted(void *array, size_t count, size_t size, unsigned imbalances, unsigned threads, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void parallelSampleSortUncounted(void *array, void *buffer, size_t count, size_t size, unsigned threads, unsigned stable, struct SampleSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void radixSortUncounted(void *array, void *buffer, size_t count, size_t size, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics);
+void radixKeySortUncounted(void *array, void *buffer, size_t count, size_t size, size_t keyWidth, struct SortingStatistics *statistics, RadixKey key, void *context);
+void stringSortUncounted(char **array, char **buffer, size_t count, struct SortingStatistics *statistics);
+void stringPrefixSortUncounted(char **array, void *buffer, size_t count, struct SortingStatistics *statistics, Compare compare, void *context);
+
+void coleArgsortUncounted(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context);
+void quickArgsortUncounted(void const *array, void *indices, size_t count, size_t size, size_t indexSize, struct SortingStatistics *statistics, Compare compare, void *context);
+void radixArgsortUncounted(void const *array, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingStatistics *statistics);
+void applyPermutationUncounted(void *array, void *indices, size_t count, size_t size, size_t indexSize, void *temporary, struct SortingStatistics *statistics);
+void coleSortPayloadsUncounted(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics, Compare compare, void *context);
+void radixSortPayloadsUncounted(void *keys, void *indices, void *buffer, size_t count, size_t size, size_t indexSize, size_t keyOffset, size_t keyWidth, struct SortingPayload const *payloads, unsigned payloadCount, void *temporary, struct SortingStatistics *statistics);
+
+int externalSortUncounted(char const *inputPath, char const *outputPath, char const *temporaryDirectory, size_t size, size_t memory, struct ExternalSortTimings *timings, struct SortingStatistics *statistics, Compare compare, void *context);
 
 #endif /* sort_h */
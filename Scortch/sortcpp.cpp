@@ -0,0 +1,123 @@
+//
+//  sortcpp.cpp
+//  Scortch
+//
+//  Checks the ordering and stability of the sort.hpp templates.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include "sort.hpp"
+
+struct Record {
+	unsigned key;
+	unsigned order;
+};
+
+static bool recordIsLess(Record const &a, Record const &b) {
+	return a.key < b.key;
+}
+
+static std::vector<Record> randomRecords(std::size_t count, unsigned keys) {
+	std::vector<Record> records(count);
+	
+	for ( std::size_t index = 0 ; index < count ; ++index ) {
+		records[index].key = static_cast<unsigned>(std::rand()) % keys;
+		records[index].order = static_cast<unsigned>(index);
+	}
+	
+	return records;
+}
+
+static bool isAscending(std::vector<Record> const &records) {
+	for ( std::size_t index = 1 ; index < records.size() ; ++index ) {
+		if ( records[index].key < records[index - 1].key ) {
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+static bool isStable(std::vector<Record> const &records) {
+	for ( std::size_t index = 1 ; index < records.size() ; ++index ) {
+		if ( records[index].key == records[index - 1].key && records[index].order < records[index - 1].order ) {
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+static void recordSortingTest(std::size_t count, unsigned keys) {
+	std::vector<Record> original = randomRecords(count, keys), records;
+	
+	records = original;
+	scortch::cole_sort(records.begin(), records.end(), recordIsLess);
+	if ( !isAscending(records) ) {
+		std::printf("•• cole_sort not ascending %zu\n", count);
+	} else if ( !isStable(records) ) {
+		std::printf("•• cole_sort not stable %zu\n", count);
+	}
+	
+	records = original;
+	scortch::tumble_merge_sort(records.begin(), records.end(), recordIsLess);
+	if ( !isAscending(records) ) {
+		std::printf("•• tumble_merge_sort not ascending %zu\n", count);
+	} else if ( !isStable(records) ) {
+		std::printf("•• tumble_merge_sort not stable %zu\n", count);
+	}
+	
+	records = original;
+	scortch::balancing_quick_sort(records.begin(), records.end(), recordIsLess);
+	if ( !isAscending(records) ) {
+		std::printf("•• balancing_quick_sort not ascending %zu\n", count);
+	}
+}
+
+static void stringSortingTest(std::size_t count) {
+	std::vector<std::string> original(count), strings;
+	
+	for ( std::size_t index = 0 ; index < count ; ++index ) {
+		original[index] = std::to_string(std::rand() % (count + 1));
+	}
+	
+	strings = original;
+	scortch::cole_sort(strings.begin(), strings.end());
+	if ( !std::is_sorted(strings.begin(), strings.end()) ) {
+		std::printf("•• cole_sort strings not ascending %zu\n", count);
+	}
+	
+	strings = original;
+	scortch::tumble_merge_sort(strings.begin(), strings.end());
+	if ( !std::is_sorted(strings.begin(), strings.end()) ) {
+		std::printf("•• tumble_merge_sort strings not ascending %zu\n", count);
+	}
+	
+	strings = original;
+	scortch::balancing_quick_sort(strings.begin(), strings.end(), std::greater<std::string>());
+	if ( !std::is_sorted(strings.begin(), strings.end(), std::greater<std::string>()) ) {
+		std::printf("•• balancing_quick_sort strings not descending %zu\n", count);
+	}
+}
+
+int main(int argc, const char * argv[]) {
+	std::size_t counts[] = {0, 1, 7, 102, 1024, 10007, 100003};
+	unsigned keys[] = {2, 4, 1000, 1u << 31};
+	
+	for ( std::size_t count : counts ) {
+		std::printf("-- sort.hpp records %zu\n", count);
+		
+		for ( unsigned key : keys ) {
+			recordSortingTest(count, key);
+		}
+		
+		stringSortingTest(count);
+	}
+	
+	return 0;
+}
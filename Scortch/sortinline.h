@@ -0,0 +1,428 @@
+//
+//  sortinline.h
+//  Scortch
+//
+//  Generates sorting functions for one element type with the comparison inlined.
+//  Include once for each type after defining:
+//
+//  SORT_NAME				suffix for the generated functions, coleSort ## SORT_NAME
+//  SORT_TYPE				element type, which must be assignable
+//  SORT_IS_LESS(a, b)		expression that is true when element a sorts before element b
+//
+//  The expression is given elements, not pointers, and may use the context parameter.
+//
+//	#define SORT_NAME Unsigned
+//	#define SORT_TYPE unsigned
+//	#define SORT_IS_LESS(a, b) ((a) < (b))
+//	#include "sortinline.h"
+//
+//	coleSortUnsigned(array, buffer, count, NULL);
+//
+//  Generated functions are static and mirror the generic versions in sort.c without the
+//  size, statistics, or compare parameters.  Descending runs end at equal elements because
+//  only less than is available.
+//
+
+#ifndef sortinline_h
+#define sortinline_h
+
+#include <string.h>
+
+#define SORT_JOINED(a, b) a ## b
+#define SORT_JOIN(a, b) SORT_JOINED(a, b)
+#define SORT_NAMED(name) SORT_JOIN(name, SORT_NAME)
+
+#endif /* sortinline_h */
+
+#if !defined(SORT_NAME) || !defined(SORT_TYPE) || !defined(SORT_IS_LESS)
+#error "define SORT_NAME, SORT_TYPE, and SORT_IS_LESS before including sortinline.h"
+#endif
+
+//	MARK: - Data Motion
+
+static inline void SORT_NAMED(reverse)(SORT_TYPE *array, size_t count) {
+	SORT_TYPE t;
+	size_t from, to;
+	
+	for ( from = 0, to = count - 1 ; from < to ; ++from, --to ) {
+		t = array[from];
+		array[from] = array[to];
+		array[to] = t;
+	}
+}
+
+//	MARK: - Binary Insertion Sort
+
+///	Insertion sort that uses a binary search to place each element
+static inline void SORT_NAMED(binaryInsertionSort)(SORT_TYPE *array, size_t count, size_t sorted, void *context) {
+	SORT_TYPE t;
+	size_t i, m, n, o;
+	
+	for ( i = sorted ; i < count ; ++i ) {
+		m = 1;
+		n = i;
+		
+		while ( m <= n ) {
+			o = (m + n) / 2 - 1;
+			
+			if ( SORT_IS_LESS(array[i], array[o]) ) {
+				n = o;
+			} else {
+				m = o + 2;
+			}
+		}
+		
+		if ( m <= i ) {
+			t = array[i];
+			memmove(array + m, array + m - 1, (i - m + 1) * sizeof(SORT_TYPE));
+			array[m - 1] = t;
+		}
+	}
+}
+
+//	MARK: - Cole Sort
+
+static inline void SORT_NAMED(coleMergeIntoSorted)(SORT_TYPE const *unmerged, SORT_TYPE *merged, size_t count, size_t split, void *context) {
+	if ( !(0 < split && split < count) ) {
+		memmove(merged, unmerged, count * sizeof(SORT_TYPE));
+		return;
+	}
+	
+	size_t i, j, m, n, o = count - split;
+	
+	//	small + large > small * log2(large)
+	//	+3 to avoid edge cases for very small values
+	
+	if ( (o + 3) >> (o / split) <= 1 ) {
+		for ( i = 0, j = split ; i < split ; ++i ) {
+			m = j;
+			n = count - 1;
+			
+			while ( m <= n ) {
+				o = (m + n) / 2;
+				
+				if ( SORT_IS_LESS(unmerged[o], unmerged[i]) ) {
+					m = o + 1;
+				} else {
+					n = o - 1;
+				}
+			}
+			
+			memmove(merged + i + j - split, unmerged + j, (m - j) * sizeof(SORT_TYPE));
+			merged[i + m - split] = unmerged[i];
+			
+			j = m;
+		}
+		
+		memmove(merged + j, unmerged + j, (count - j) * sizeof(SORT_TYPE));
+		return;
+	}
+	
+	if ( (split + 3) >> (split / o) <= 1 ) {
+		for ( i = 0, j = split ; j < count ; ++j ) {
+			m = i + 1;
+			n = split;
+			
+			while ( m <= n ) {
+				o = (m + n) / 2 - 1;
+				
+				if ( SORT_IS_LESS(unmerged[j], unmerged[o]) ) {
+					n = o;
+				} else {
+					m = o + 2;
+				}
+			}
+			
+			m -= 1;
+			
+			memmove(merged + i + j - split, unmerged + i, (m - i) * sizeof(SORT_TYPE));
+			merged[j + m - split] = unmerged[j];
+			
+			i = m;
+		}
+		
+		memmove(merged + count - split + i, unmerged + i, (split - i) * sizeof(SORT_TYPE));
+		return;
+	}
+	
+	SORT_TYPE const *u = unmerged;
+	SORT_TYPE const *v = unmerged + split;
+	SORT_TYPE const *uEnd = v;
+	SORT_TYPE const *vEnd = unmerged + count;
+	SORT_TYPE *w = merged;
+	
+	for ( ;; ) {
+		if ( SORT_IS_LESS(*v, *u) ) {
+			*w++ = *v++;
+			
+			if ( v == vEnd ) {
+				memmove(w, u, (uEnd - u) * sizeof(SORT_TYPE));
+				break;
+			}
+		} else {
+			*w++ = *u++;
+			
+			if ( u == uEnd ) {
+				memmove(w, v, (vEnd - v) * sizeof(SORT_TYPE));
+				break;
+			}
+		}
+	}
+}
+
+static inline void SORT_NAMED(coleMergeSorted)(SORT_TYPE *array, size_t runs[4], SORT_TYPE *buffer, void *context) {
+	size_t a = 0, b = runs[0], c = runs[1] + b, d = runs[2] + c, e = runs[3] + d;
+	
+	if ( b == e ) {
+		return;
+	} else if ( b == c || !SORT_IS_LESS(array[b], array[b - 1]) ) {
+		memmove(buffer + a, array, (c - a) * sizeof(SORT_TYPE));
+	} else if ( SORT_IS_LESS(array[c - 1], array[a]) ) {
+		memmove(buffer + a, array + b, (c - b) * sizeof(SORT_TYPE));
+		memmove(buffer + a + c - b, array, (b - a) * sizeof(SORT_TYPE));
+	} else {
+		SORT_NAMED(coleMergeIntoSorted)(array, buffer, c - a, b - a, context);
+	}
+	
+	if ( c == e ) {
+		//
+	} else if ( d == e || !SORT_IS_LESS(array[d], array[d - 1]) ) {
+		memmove(buffer + c, array + c, (e - c) * sizeof(SORT_TYPE));
+	} else if ( SORT_IS_LESS(array[e - 1], array[c]) ) {
+		memmove(buffer + c, array + d, (e - d) * sizeof(SORT_TYPE));
+		memmove(buffer + c + e - d, array + c, (d - c) * sizeof(SORT_TYPE));
+	} else {
+		SORT_NAMED(coleMergeIntoSorted)(array + c, buffer + c, e - c, d - c, context);
+	}
+	
+	SORT_NAMED(coleMergeIntoSorted)(buffer, array, e, c, context);
+}
+
+static inline size_t SORT_NAMED(coleSeek)(SORT_TYPE *array, SORT_TYPE *buffer, size_t count, size_t minimum, void *context) {
+	if ( count < 2 ) {
+		return count;
+	}
+	
+	size_t minimumRun = 8;
+	size_t runs[4] = {0};
+	size_t run = 0, sum = 0, seek, limit;
+	unsigned i, isReversed;
+	
+	for ( i = 0 ; i < 4 && run + 1 < count ; ++i ) {
+		isReversed = SORT_IS_LESS(array[run + 1], array[run]);
+		run += 2;
+		
+		if ( isReversed ) {
+			while ( run < count && SORT_IS_LESS(array[run], array[run - 1]) ) {
+				run += 1;
+			}
+			
+			SORT_NAMED(reverse)(array + sum, run - sum);
+		} else {
+			while ( run < count && !SORT_IS_LESS(array[run], array[run - 1]) ) {
+				run += 1;
+			}
+		}
+		
+		if ( run < sum + minimumRun && run + 1 < minimum ) {
+			limit = count < sum + minimumRun ? count - sum : minimumRun;
+			
+			SORT_NAMED(binaryInsertionSort)(array + sum, limit, run - sum, context);
+			
+			run = sum + limit;
+		}
+		
+		runs[i] = run - sum;
+		sum = run;
+	}
+	
+	if ( run + 1 == count ) {
+		limit = runs[i - 1];
+		
+		if ( i < 4 ) {
+			runs[i] = 1;
+			i += 1;
+		} else {
+			SORT_NAMED(binaryInsertionSort)(array + sum - limit, limit + 1, limit, context);
+			runs[i - 1] += 1;
+		}
+		
+		run += 1;
+		sum = run;
+	}
+	
+	SORT_NAMED(coleMergeSorted)(array, runs, buffer, context);
+	
+	while ( run < minimum ) {
+		runs[0] = run;
+		runs[2] = 0;
+		runs[3] = 0;
+		seek = run > minimumRun * 4 ? run * 3 / 4 : run;
+		
+		for ( i = 1 ; i < 4 && sum < count ; ++i ) {
+			limit = count - sum;
+			seek = limit < seek ? limit : seek;
+			
+			run = SORT_NAMED(coleSeek)(array + sum, buffer, limit, seek, context);
+			sum += run;
+			runs[i] = run;
+		}
+		
+		if ( i == 3 && runs[2] < runs[0] && (runs[0] + runs[1] + 3) >> ((runs[0] + runs[1]) / runs[2]) > 1 ) {
+			runs[3] = runs[2];
+			runs[2] = runs[1];
+			runs[1] = 0;
+			i = 4;
+		}
+		
+		SORT_NAMED(coleMergeSorted)(array, runs, buffer, context);
+		run = sum;
+	}
+	
+	return sum;
+}
+
+///	Merge sort that operates on four runs at a time, starting with natural ascending or descending runs
+static inline void SORT_NAMED(coleSort)(SORT_TYPE *array, SORT_TYPE *buffer, size_t count, void *context) {
+	if ( count < 8 ) {
+		SORT_NAMED(binaryInsertionSort)(array, count, 1, context);
+		return;
+	}
+	
+	SORT_NAMED(coleSeek)(array, buffer, count, count, context);
+}
+
+//	MARK: - Heap Sort
+
+static inline void SORT_NAMED(heapSift)(SORT_TYPE *array, size_t start, size_t end, void *context) {
+	SORT_TYPE t;
+	size_t i = start, j = start;
+	size_t a, b;
+	unsigned d = 0;
+	
+	while ( j * 2 + 2 <= end ) {
+		if ( SORT_IS_LESS(array[j * 2 + 1], array[j * 2 + 2]) ) {
+			j = j * 2 + 2;
+		} else {
+			j = j * 2 + 1;
+		}
+		d += 1;
+	}
+	
+	while ( j * 2 + 1 <= end ) {
+		j = j * 2 + 1;
+		d += 1;
+	}
+	
+	while ( SORT_IS_LESS(array[j], array[i]) ) {
+		j = (j - 1) / 2;
+		d -= 1;
+	}
+	
+	if ( d > 0 ) {
+		t = array[i];
+		
+		while ( d --> 0 ) {
+			a = (j + 1 - ((size_t)1 << d)) >> d;
+			b = (a - 1) >> 1;
+			array[b] = array[a];
+		}
+		
+		array[j] = t;
+	}
+}
+
+///	Heap Sort organizes elements into a heap then extracts elements from the heap in sorted order
+static inline void SORT_NAMED(heapSort)(SORT_TYPE *array, size_t count, void *context) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	SORT_TYPE t;
+	size_t start = count / 2;
+	
+	while ( start > 0 ) {
+		start -= 1;
+		
+		SORT_NAMED(heapSift)(array, start, count - 1, context);
+	}
+	
+	size_t end = count - 1;
+	
+	while ( end > 0 ) {
+		t = array[0];
+		array[0] = array[end];
+		array[end] = t;
+		
+		end -= 1;
+		
+		SORT_NAMED(heapSift)(array, 0, end, context);
+	}
+}
+
+//	MARK: - Quick Sort
+
+static inline size_t SORT_NAMED(quickPartition)(SORT_TYPE *array, size_t count, void *context) {
+	SORT_TYPE t;
+	size_t pivot = count / 2;
+	size_t lower = 0, upper = count - 1;
+	
+	if ( SORT_IS_LESS(array[pivot], array[lower]) ) {
+		t = array[pivot]; array[pivot] = array[lower]; array[lower] = t;
+	}
+	
+	if ( SORT_IS_LESS(array[upper], array[pivot]) ) {
+		t = array[pivot]; array[pivot] = array[upper]; array[upper] = t;
+		
+		if ( SORT_IS_LESS(array[pivot], array[lower]) ) {
+			t = array[pivot]; array[pivot] = array[lower]; array[lower] = t;
+		}
+	}
+	
+	for ( ;; ) {
+		do {
+			lower += 1;
+		} while ( SORT_IS_LESS(array[lower], array[pivot]) );
+		
+		do {
+			upper -= 1;
+		} while ( SORT_IS_LESS(array[pivot], array[upper]) );
+		
+		if ( lower < upper ) {
+			t = array[lower]; array[lower] = array[upper]; array[upper] = t;
+			
+			if ( pivot == lower ) {
+				pivot = upper;
+			} else if ( pivot == upper ) {
+				pivot = lower;
+			}
+		} else {
+			break;
+		}
+	}
+	
+	return 1 + upper;
+}
+
+/// Self balancing quick sort that use an alternate sorting algorithm on affected regions after several pivots in a row are imbalanced
+static inline void SORT_NAMED(balancingQuickSort)(SORT_TYPE *array, size_t count, unsigned imbalances, void *context) {
+	if ( count < 2 ) {
+		return;
+	} else if ( count < 16 ) {
+		SORT_NAMED(binaryInsertionSort)(array, count, 1, context);
+	} else if ( imbalances > 4 ) {
+		SORT_NAMED(heapSort)(array, count, context);
+	} else {
+		size_t pivot = SORT_NAMED(quickPartition)(array, count, context);
+		size_t ratio = 12;
+		
+		imbalances = count > ratio * (count - pivot - 1 < pivot ? count - pivot - 1 : pivot) ? imbalances + 1 : 0;
+		
+		SORT_NAMED(balancingQuickSort)(array, pivot, imbalances, context);
+		SORT_NAMED(balancingQuickSort)(array + pivot, count - pivot, imbalances, context);
+	}
+}
+
+#undef SORT_NAME
+#undef SORT_TYPE
+#undef SORT_IS_LESS
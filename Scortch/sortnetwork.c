@@ -0,0 +1,473 @@
+//
+//  sortnetwork.c
+//  Scortch
+//
+//  Compare functions for primitive keys and bitonic sorting networks that sort small blocks
+//  of those keys in AVX2 vector registers.  The sorts in sort.c recognize these compare
+//  functions and use the networks to build their initial sorted blocks.
+//
+
+#include <stdint.h>
+#include <string.h>
+#include "sort.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SORTING_NETWORK_AVX2 1
+#include <immintrin.h>
+#else
+#define SORTING_NETWORK_AVX2 0
+#endif
+
+#define kNetworkWidth32 16
+#define kNetworkWidth64 8
+
+enum NetworkKey {
+	kNetworkKeyNone,
+	kNetworkKeyInt32,
+	kNetworkKeyUInt32,
+	kNetworkKeyFloat32,
+	kNetworkKeyInt64,
+	kNetworkKeyUInt64,
+	kNetworkKeyFloat64
+};
+
+//	MARK: - Primitive Keys
+
+///	Float bits as a signed integer with the same total order, -NaN < -∞ < -0 < +0 < +∞ < +NaN
+static inline int32_t orderedFloat32(void const *p) {
+	int32_t x;
+	memcpy(&x, p, sizeof(x));
+	return x ^ ((x >> 31) & 0x7FFFFFFF);
+}
+
+static inline int64_t orderedFloat64(void const *p) {
+	int64_t x;
+	memcpy(&x, p, sizeof(x));
+	return x ^ ((x >> 63) & 0x7FFFFFFFFFFFFFFF);
+}
+
+signed compareInt32(void const *a, void const *b, void *context) {
+	int32_t x = *(int32_t const *)a, y = *(int32_t const *)b;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+signed compareUInt32(void const *a, void const *b, void *context) {
+	uint32_t x = *(uint32_t const *)a, y = *(uint32_t const *)b;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+signed compareFloat32(void const *a, void const *b, void *context) {
+	int32_t x = orderedFloat32(a), y = orderedFloat32(b);
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+signed compareInt64(void const *a, void const *b, void *context) {
+	int64_t x = *(int64_t const *)a, y = *(int64_t const *)b;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+signed compareUInt64(void const *a, void const *b, void *context) {
+	uint64_t x = *(uint64_t const *)a, y = *(uint64_t const *)b;
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+signed compareFloat64(void const *a, void const *b, void *context) {
+	int64_t x = orderedFloat64(a), y = orderedFloat64(b);
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static enum NetworkKey networkKey(size_t size, Compare compare) {
+	if ( size == 4 ) {
+		if ( compare == compareInt32 ) { return kNetworkKeyInt32; }
+		if ( compare == compareUInt32 ) { return kNetworkKeyUInt32; }
+		if ( compare == compareFloat32 ) { return kNetworkKeyFloat32; }
+	} else if ( size == 8 ) {
+		if ( compare == compareInt64 ) { return kNetworkKeyInt64; }
+		if ( compare == compareUInt64 ) { return kNetworkKeyUInt64; }
+		if ( compare == compareFloat64 ) { return kNetworkKeyFloat64; }
+	}
+	
+	return kNetworkKeyNone;
+}
+
+#if SORTING_NETWORK_AVX2
+
+//	MARK: - 32 Bit Network
+
+#define kAVX2 __attribute__((target("avx2")))
+
+//	each layer compares every lane with the partner lane and keeps the max in the lanes set in mask
+#define networkLayer32(v, partner, mask) _mm256_blend_epi32(_mm256_min_epi32(v, partner), _mm256_max_epi32(v, partner), mask)
+
+///	Sorts a bitonic register
+static inline kAVX2 __m256i networkMerge8x32(__m256i v) {
+	v = networkLayer32(v, _mm256_permute4x64_epi64(v, 0x4E), 0xF0);
+	v = networkLayer32(v, _mm256_shuffle_epi32(v, 0x4E), 0xCC);
+	v = networkLayer32(v, _mm256_shuffle_epi32(v, 0xB1), 0xAA);
+	
+	return v;
+}
+
+static inline kAVX2 __m256i networkSort8x32(__m256i v) {
+	v = networkLayer32(v, _mm256_shuffle_epi32(v, 0xB1), 0x66);
+	v = networkLayer32(v, _mm256_shuffle_epi32(v, 0x4E), 0x3C);
+	v = networkLayer32(v, _mm256_shuffle_epi32(v, 0xB1), 0x5A);
+	
+	return networkMerge8x32(v);
+}
+
+static inline kAVX2 __m256i networkReverse8x32(__m256i v) {
+	return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+///	Merges two sorted registers into a lower and upper sorted register
+static inline kAVX2 void networkMerge16x32(__m256i *a, __m256i *b) {
+	__m256i r = networkReverse8x32(*b);
+	__m256i lower = _mm256_min_epi32(*a, r);
+	__m256i upper = _mm256_max_epi32(*a, r);
+	
+	*a = networkMerge8x32(lower);
+	*b = networkMerge8x32(upper);
+}
+
+static inline kAVX2 void networkSort16x32(__m256i *a, __m256i *b) {
+	*a = networkSort8x32(*a);
+	*b = networkSort8x32(*b);
+	
+	networkMerge16x32(a, b);
+}
+
+static inline kAVX2 void networkSort32x32(__m256i v[4]) {
+	networkSort16x32(v + 0, v + 1);
+	networkSort16x32(v + 2, v + 3);
+	
+	__m256i r2 = networkReverse8x32(v[3]);
+	__m256i r3 = networkReverse8x32(v[2]);
+	__m256i l0 = _mm256_min_epi32(v[0], r2), h0 = _mm256_max_epi32(v[0], r2);
+	__m256i l1 = _mm256_min_epi32(v[1], r3), h1 = _mm256_max_epi32(v[1], r3);
+	
+	v[0] = networkMerge8x32(_mm256_min_epi32(l0, l1));
+	v[1] = networkMerge8x32(_mm256_max_epi32(l0, l1));
+	v[2] = networkMerge8x32(_mm256_min_epi32(h0, h1));
+	v[3] = networkMerge8x32(_mm256_max_epi32(h0, h1));
+}
+
+///	Converts keys to or from signed integers with the same order, each conversion is its own inverse
+static inline kAVX2 __m256i networkOrdered32(__m256i v, enum NetworkKey key) {
+	switch ( key ) {
+	case kNetworkKeyUInt32: return _mm256_xor_si256(v, _mm256_set1_epi32(INT32_MIN));
+	case kNetworkKeyFloat32: return _mm256_xor_si256(v, _mm256_and_si256(_mm256_srai_epi32(v, 31), _mm256_set1_epi32(INT32_MAX)));
+	default: return v;
+	}
+}
+
+static kAVX2 size_t networkSort32(void const *unsorted, void *sorted, size_t count, enum NetworkKey key) {
+	__m256i v[4], mask[4];
+	__m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i maximum = _mm256_set1_epi32(INT32_MAX);
+	unsigned i, registers = count <= 8 ? 1 : count <= 16 ? 2 : 4;
+	
+	for ( i = 0 ; i < registers ; ++i ) {
+		mask[i] = _mm256_cmpgt_epi32(_mm256_set1_epi32((int32_t)count - (int32_t)(i * 8)), lanes);
+		v[i] = _mm256_maskload_epi32((int const *)unsorted + i * 8, mask[i]);
+		v[i] = _mm256_blendv_epi8(maximum, networkOrdered32(v[i], key), mask[i]);
+	}
+	
+	switch ( registers ) {
+	case 1: v[0] = networkSort8x32(v[0]); break;
+	case 2: networkSort16x32(v + 0, v + 1); break;
+	default: networkSort32x32(v); break;
+	}
+	
+	for ( i = 0 ; i < registers ; ++i ) {
+		_mm256_maskstore_epi32((int *)sorted + i * 8, mask[i], networkOrdered32(v[i], key));
+	}
+	
+	return registers == 1 ? 24 : registers == 2 ? 80 : 240;
+}
+
+///	Scalar key with the same order as the vector keys
+static inline int32_t networkOrderedKey32(int32_t x, enum NetworkKey key) {
+	switch ( key ) {
+	case kNetworkKeyUInt32: return x ^ INT32_MIN;
+	case kNetworkKeyFloat32: return x ^ ((x >> 31) & INT32_MAX);
+	default: return x;
+	}
+}
+
+static inline kAVX2 __m256i networkLoad32(int32_t const *p, size_t remaining, enum NetworkKey key) {
+	if ( remaining >= 8 ) {
+		return networkOrdered32(_mm256_loadu_si256((__m256i const *)p), key);
+	}
+	
+	//	pad the last chunk of a run with the maximum key, which sorts after every real key
+	__m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int32_t)remaining), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	
+	return _mm256_blendv_epi8(_mm256_set1_epi32(INT32_MAX), networkOrdered32(_mm256_maskload_epi32((int const *)p, mask), key), mask);
+}
+
+static inline kAVX2 void networkStore32(int32_t *p, size_t remaining, __m256i v, enum NetworkKey key) {
+	if ( remaining >= 8 ) {
+		_mm256_storeu_si256((__m256i *)p, networkOrdered32(v, key));
+	} else {
+		_mm256_maskstore_epi32((int *)p, _mm256_cmpgt_epi32(_mm256_set1_epi32((int32_t)remaining), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)), networkOrdered32(v, key));
+	}
+}
+
+///	Merges two sorted runs eight keys at a time, loading the next chunk from whichever run has the lesser next key
+static kAVX2 size_t networkMerge32(int32_t const *u, size_t m, int32_t const *v, size_t n, int32_t *merged, enum NetworkKey key) {
+	size_t i = 0, j = 0, o = 0, count = m + n, steps = 0;
+	__m256i lower = networkLoad32(u, m, key);
+	__m256i upper = networkLoad32(v, n, key);
+	
+	i += 8;
+	j += 8;
+	
+	for ( ;; ) {
+		networkMerge16x32(&lower, &upper);
+		networkStore32(merged + o, count - o, lower, key);
+		o += 8;
+		steps += 1;
+		
+		if ( !(o < count) ) {
+			break;
+		}
+		
+		if ( j < n && (!(i < m) || networkOrderedKey32(v[j], key) < networkOrderedKey32(u[i], key)) ) {
+			lower = networkLoad32(v + j, n - j, key);
+			j += 8;
+		} else if ( i < m ) {
+			lower = networkLoad32(u + i, m - i, key);
+			i += 8;
+		} else {
+			networkStore32(merged + o, count - o, upper, key);
+			break;
+		}
+	}
+	
+	return steps * 33;
+}
+
+//	MARK: - 64 Bit Network
+
+static inline kAVX2 __m256i networkMinimum64(__m256i a, __m256i b) {
+	return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+static inline kAVX2 __m256i networkMaximum64(__m256i a, __m256i b) {
+	return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+//	mask selects 32 bit halves, so each 64 bit lane is two bits of mask
+#define networkLayer64(v, partner, mask) _mm256_blend_epi32(networkMinimum64(v, partner), networkMaximum64(v, partner), mask)
+
+static inline kAVX2 __m256i networkMerge4x64(__m256i v) {
+	v = networkLayer64(v, _mm256_permute4x64_epi64(v, 0x4E), 0xF0);
+	v = networkLayer64(v, _mm256_permute4x64_epi64(v, 0xB1), 0xCC);
+	
+	return v;
+}
+
+static inline kAVX2 __m256i networkSort4x64(__m256i v) {
+	v = networkLayer64(v, _mm256_permute4x64_epi64(v, 0xB1), 0x3C);
+	
+	return networkMerge4x64(v);
+}
+
+static inline kAVX2 void networkMerge8x64(__m256i *a, __m256i *b) {
+	__m256i r = _mm256_permute4x64_epi64(*b, 0x1B);
+	__m256i lower = networkMinimum64(*a, r);
+	__m256i upper = networkMaximum64(*a, r);
+	
+	*a = networkMerge4x64(lower);
+	*b = networkMerge4x64(upper);
+}
+
+static inline kAVX2 void networkSort8x64(__m256i *a, __m256i *b) {
+	*a = networkSort4x64(*a);
+	*b = networkSort4x64(*b);
+	
+	networkMerge8x64(a, b);
+}
+
+static inline kAVX2 void networkSort16x64(__m256i v[4]) {
+	networkSort8x64(v + 0, v + 1);
+	networkSort8x64(v + 2, v + 3);
+	
+	__m256i r2 = _mm256_permute4x64_epi64(v[3], 0x1B);
+	__m256i r3 = _mm256_permute4x64_epi64(v[2], 0x1B);
+	__m256i l0 = networkMinimum64(v[0], r2), h0 = networkMaximum64(v[0], r2);
+	__m256i l1 = networkMinimum64(v[1], r3), h1 = networkMaximum64(v[1], r3);
+	
+	v[0] = networkMerge4x64(networkMinimum64(l0, l1));
+	v[1] = networkMerge4x64(networkMaximum64(l0, l1));
+	v[2] = networkMerge4x64(networkMinimum64(h0, h1));
+	v[3] = networkMerge4x64(networkMaximum64(h0, h1));
+}
+
+static inline kAVX2 __m256i networkOrdered64(__m256i v, enum NetworkKey key) {
+	switch ( key ) {
+	case kNetworkKeyUInt64: return _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN));
+	case kNetworkKeyFloat64: return _mm256_xor_si256(v, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), v), _mm256_set1_epi64x(INT64_MAX)));
+	default: return v;
+	}
+}
+
+static kAVX2 size_t networkSort64(void const *unsorted, void *sorted, size_t count, enum NetworkKey key) {
+	__m256i v[4], mask[4];
+	__m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+	__m256i maximum = _mm256_set1_epi64x(INT64_MAX);
+	unsigned i, registers = count <= 4 ? 1 : count <= 8 ? 2 : 4;
+	
+	for ( i = 0 ; i < registers ; ++i ) {
+		mask[i] = _mm256_cmpgt_epi64(_mm256_set1_epi64x((int64_t)count - (int64_t)(i * 4)), lanes);
+		v[i] = _mm256_maskload_epi64((long long const *)unsorted + i * 4, mask[i]);
+		v[i] = _mm256_blendv_epi8(maximum, networkOrdered64(v[i], key), mask[i]);
+	}
+	
+	switch ( registers ) {
+	case 1: v[0] = networkSort4x64(v[0]); break;
+	case 2: networkSort8x64(v + 0, v + 1); break;
+	default: networkSort16x64(v); break;
+	}
+	
+	for ( i = 0 ; i < registers ; ++i ) {
+		_mm256_maskstore_epi64((long long *)sorted + i * 4, mask[i], networkOrdered64(v[i], key));
+	}
+	
+	return registers == 1 ? 6 : registers == 2 ? 24 : 80;
+}
+
+static inline int64_t networkOrderedKey64(int64_t x, enum NetworkKey key) {
+	switch ( key ) {
+	case kNetworkKeyUInt64: return x ^ INT64_MIN;
+	case kNetworkKeyFloat64: return x ^ ((x >> 63) & INT64_MAX);
+	default: return x;
+	}
+}
+
+static inline kAVX2 __m256i networkLoad64(int64_t const *p, size_t remaining, enum NetworkKey key) {
+	if ( remaining >= 4 ) {
+		return networkOrdered64(_mm256_loadu_si256((__m256i const *)p), key);
+	}
+	
+	__m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((int64_t)remaining), _mm256_setr_epi64x(0, 1, 2, 3));
+	
+	return _mm256_blendv_epi8(_mm256_set1_epi64x(INT64_MAX), networkOrdered64(_mm256_maskload_epi64((long long const *)p, mask), key), mask);
+}
+
+static inline kAVX2 void networkStore64(int64_t *p, size_t remaining, __m256i v, enum NetworkKey key) {
+	if ( remaining >= 4 ) {
+		_mm256_storeu_si256((__m256i *)p, networkOrdered64(v, key));
+	} else {
+		_mm256_maskstore_epi64((long long *)p, _mm256_cmpgt_epi64(_mm256_set1_epi64x((int64_t)remaining), _mm256_setr_epi64x(0, 1, 2, 3)), networkOrdered64(v, key));
+	}
+}
+
+static kAVX2 size_t networkMerge64(int64_t const *u, size_t m, int64_t const *v, size_t n, int64_t *merged, enum NetworkKey key) {
+	size_t i = 0, j = 0, o = 0, count = m + n, steps = 0;
+	__m256i lower = networkLoad64(u, m, key);
+	__m256i upper = networkLoad64(v, n, key);
+	
+	i += 4;
+	j += 4;
+	
+	for ( ;; ) {
+		networkMerge8x64(&lower, &upper);
+		networkStore64(merged + o, count - o, lower, key);
+		o += 4;
+		steps += 1;
+		
+		if ( !(o < count) ) {
+			break;
+		}
+		
+		if ( j < n && (!(i < m) || networkOrderedKey64(v[j], key) < networkOrderedKey64(u[i], key)) ) {
+			lower = networkLoad64(v + j, n - j, key);
+			j += 4;
+		} else if ( i < m ) {
+			lower = networkLoad64(u + i, m - i, key);
+			i += 4;
+		} else {
+			networkStore64(merged + o, count - o, upper, key);
+			break;
+		}
+	}
+	
+	return steps * 13;
+}
+
+static unsigned networkAvailable() {
+	static signed available = -1;
+	
+	if ( available < 0 ) {
+		__builtin_cpu_init();
+		available = __builtin_cpu_supports("avx2") ? 1 : 0;
+	}
+	
+	return available;
+}
+
+#else
+
+static unsigned networkAvailable() {
+	return 0;
+}
+
+#endif
+
+//	MARK: - Sorting Network
+
+size_t networkSortWidth(size_t size, Compare compare) {
+	enum NetworkKey key = networkKey(size, compare);
+	
+	if ( key == kNetworkKeyNone || !networkAvailable() ) {
+		return 0;
+	}
+	
+	return size == 4 ? kNetworkWidth32 : kNetworkWidth64;
+}
+
+size_t networkSort(void const *unsorted, void *sorted, size_t count, size_t size, Compare compare) {
+	enum NetworkKey key = networkKey(size, compare);
+	
+	if ( key == kNetworkKeyNone || !networkAvailable() || count > 32 * 4 / size ) {
+		return 0;
+	}
+
+#if SORTING_NETWORK_AVX2
+	if ( size == 4 ) {
+		return networkSort32(unsorted, sorted, count, key);
+	} else {
+		return networkSort64(unsorted, sorted, count, key);
+	}
+#else
+	return 0;
+#endif
+}
+
+size_t networkMergeRuns(void const *lower, size_t lowerCount, void const *upper, size_t upperCount, void *merged, size_t size, Compare compare) {
+	enum NetworkKey key = networkKey(size, compare);
+	
+	if ( key == kNetworkKeyNone || !networkAvailable() || !lowerCount || !upperCount ) {
+		return 0;
+	}
+
+#if SORTING_NETWORK_AVX2
+	if ( size == 4 ) {
+		return networkMerge32(lower, lowerCount, upper, upperCount, merged, key);
+	} else {
+		return networkMerge64(lower, lowerCount, upper, upperCount, merged, key);
+	}
+#else
+	return 0;
+#endif
+}
+
+size_t networkMerge(void const *unmerged, void *merged, size_t count, size_t split, size_t size, Compare compare) {
+	if ( !(0 < split && split < count) ) {
+		return 0;
+	}
+	
+	return networkMergeRuns(unmerged, split, unmerged + split * size, count - split, merged, size, compare);
+}
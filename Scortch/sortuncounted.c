@@ -0,0 +1,53 @@
+//
+//  sortuncounted.c
+//  Scortch
+//
+//  Compiles sort.c a second time with all statistics removed.
+//  Every function exported by sort.c is renamed here to its Uncounted variant.
+//
+
+#define SORTING_STATISTICS 0
+
+#define reverse reverseUncounted
+#define binaryInsertionSort binaryInsertionSortUncounted
+#define binaryMoveSort binaryMoveSortUncounted
+#define mergeSort mergeSortUncounted
+#define insertionMergeSort insertionMergeSortUncounted
+#define bottomUpMergeSort bottomUpMergeSortUncounted
+#define seriesMergeSort seriesMergeSortUncounted
+#define mergeFourSort mergeFourSortUncounted
+#define bottomUpMergeFourSort bottomUpMergeFourSortUncounted
+#define coleSort coleSortUncounted
+#define halfColeSort halfColeSortUncounted
+#define powerColeSort powerColeSortUncounted
+#define coleSortAppended coleSortAppendedUncounted
+#define blockMergeSort blockMergeSortUncounted
+#define parallelColeSort parallelColeSortUncounted
+#define parallelMergeSorted parallelMergeSortedUncounted
+#define tumbleMergeSort tumbleMergeSortUncounted
+#define polymergeSort polymergeSortUncounted
+#define bottomUpPolymergeSort bottomUpPolymergeSortUncounted
+#define juggleMergeSort juggleMergeSortUncounted
+#define heapSort heapSortUncounted
+#define quickSort quickSortUncounted
+#define balancingQuickSort balancingQuickSortUncounted
+#define patternDefeatingQuickSort patternDefeatingQuickSortUncounted
+#define threeWayQuickSort threeWayQuickSortUncounted
+#define partialSort partialSortUncounted
+#define quickSelect quickSelectUncounted
+#define quickMultiSelect quickMultiSelectUncounted
+#define parallelBalancingQuickSort parallelBalancingQuickSortUncounted
+#define parallelSampleSort parallelSampleSortUncounted
+#define radixSort radixSortUncounted
+#define radixKeySort radixKeySortUncounted
+#define stringSort stringSortUncounted
+#define stringPrefixSort stringPrefixSortUncounted
+#define coleArgsort coleArgsortUncounted
+#define quickArgsort quickArgsortUncounted
+#define radixArgsort radixArgsortUncounted
+#define applyPermutation applyPermutationUncounted
+#define coleSortPayloads coleSortPayloadsUncounted
+#define radixSortPayloads radixSortPayloadsUncounted
+#define externalSort externalSortUncounted
+
+#include "sort.c"
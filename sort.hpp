@@ -0,0 +1,696 @@
+//
+//  sort.hpp
+//  Scortch
+//
+//  Header only C++ templates of coleSort, tumbleMergeSort, and balancingQuickSort.
+//
+//  Any random access iterator can be sorted.  Elements are moved with move construction and
+//  move assignment instead of memmove, so types with heap members like std::string sort
+//  without copies, and comparison functors are invoked directly so they can be inlined.
+//
+//	std::vector<std::string> names = ...;
+//	scortch::cole_sort(names.begin(), names.end());
+//	scortch::balancing_quick_sort(names.begin(), names.end(), std::greater<std::string>());
+//
+//  The merge sorts allocate a buffer of moved-from elements the same size as the range.
+//  Only less than is available, so descending runs end at equal elements to preserve stability.
+//
+
+#ifndef sort_hpp
+#define sort_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+namespace scortch {
+namespace detail {
+
+//	MARK: - Buffer
+
+///	Storage for count elements, each move constructed in a chain from seed and then moved back to seed
+template <typename T>
+class Buffer {
+public:
+	template <typename Iterator>
+	Buffer(Iterator seed, std::size_t count) : elements(nullptr), constructed(0) {
+		if ( count == 0 ) {
+			return;
+		}
+		
+		elements = static_cast<T *>(::operator new(count * sizeof(T)));
+		
+		try {
+			::new (static_cast<void *>(elements)) T(std::move(*seed));
+			constructed = 1;
+			
+			while ( constructed < count ) {
+				::new (static_cast<void *>(elements + constructed)) T(std::move(elements[constructed - 1]));
+				constructed += 1;
+			}
+			
+			*seed = std::move(elements[count - 1]);
+		} catch ( ... ) {
+			if ( constructed > 0 ) {
+				*seed = std::move(elements[constructed - 1]);
+			}
+			
+			release();
+			throw;
+		}
+	}
+	
+	~Buffer() {
+		release();
+	}
+	
+	Buffer(Buffer const &) = delete;
+	Buffer &operator=(Buffer const &) = delete;
+	
+	T *data() const {
+		return elements;
+	}
+
+private:
+	T *elements;
+	std::size_t constructed;
+	
+	void release() {
+		while ( constructed > 0 ) {
+			constructed -= 1;
+			elements[constructed].~T();
+		}
+		
+		::operator delete(elements);
+		elements = nullptr;
+	}
+};
+
+//	MARK: - Binary Insertion Sort
+
+///	Insertion sort that uses a binary search to place each element
+template <typename Iterator, typename Less>
+void binaryInsertionSort(Iterator array, std::size_t count, std::size_t sorted, Less &less) {
+	typedef typename std::iterator_traits<Iterator>::value_type Element;
+	
+	std::size_t i, m, n, o;
+	
+	for ( i = sorted ; i < count ; ++i ) {
+		m = 1;
+		n = i;
+		
+		while ( m <= n ) {
+			o = (m + n) / 2 - 1;
+			
+			if ( less(array[i], array[o]) ) {
+				n = o;
+			} else {
+				m = o + 2;
+			}
+		}
+		
+		if ( m <= i ) {
+			Element t(std::move(array[i]));
+			std::move_backward(array + (m - 1), array + i, array + (i + 1));
+			array[m - 1] = std::move(t);
+		}
+	}
+}
+
+//	MARK: - Cole Sort
+
+template <typename Input, typename Output, typename Less>
+void coleMergeIntoSorted(Input unmerged, Output merged, std::size_t count, std::size_t split, Less &less) {
+	if ( !(0 < split && split < count) ) {
+		std::move(unmerged, unmerged + count, merged);
+		return;
+	}
+	
+	std::size_t i, j, m, n, o = count - split;
+	
+	//	small + large > small * log2(large)
+	//	+3 to avoid edge cases for very small values
+	
+	if ( (o + 3) >> (o / split) <= 1 ) {
+		for ( i = 0, j = split ; i < split ; ++i ) {
+			m = j;
+			n = count - 1;
+			
+			while ( m <= n ) {
+				o = (m + n) / 2;
+				
+				if ( less(unmerged[i], unmerged[o]) ) {
+					n = o - 1;
+				} else {
+					m = o + 1;
+				}
+			}
+			
+			std::move(unmerged + j, unmerged + m, merged + (i + j - split));
+			merged[i + m - split] = std::move(unmerged[i]);
+			
+			j = m;
+		}
+		
+		std::move(unmerged + j, unmerged + count, merged + j);
+		return;
+	}
+	
+	if ( (split + 3) >> (split / o) <= 1 ) {
+		for ( i = 0, j = split ; j < count ; ++j ) {
+			m = i + 1;
+			n = split;
+			
+			while ( m <= n ) {
+				o = (m + n) / 2 - 1;
+				
+				if ( less(unmerged[j], unmerged[o]) ) {
+					n = o;
+				} else {
+					m = o + 2;
+				}
+			}
+			
+			m -= 1;
+			
+			std::move(unmerged + i, unmerged + m, merged + (i + j - split));
+			merged[j + m - split] = std::move(unmerged[j]);
+			
+			i = m;
+		}
+		
+		std::move(unmerged + i, unmerged + split, merged + (count - split + i));
+		return;
+	}
+	
+	Input u = unmerged, v = unmerged + split;
+	Input uEnd = v, vEnd = unmerged + count;
+	Output w = merged;
+	
+	for ( ;; ) {
+		if ( less(*v, *u) ) {
+			*w = std::move(*v);
+			++w;
+			++v;
+			
+			if ( v == vEnd ) {
+				std::move(u, uEnd, w);
+				break;
+			}
+		} else {
+			*w = std::move(*u);
+			++w;
+			++u;
+			
+			if ( u == uEnd ) {
+				std::move(v, vEnd, w);
+				break;
+			}
+		}
+	}
+}
+
+template <typename Iterator, typename Element, typename Less>
+void coleMergeSorted(Iterator array, std::size_t runs[4], Element *buffer, Less &less) {
+	std::size_t a = 0, b = runs[0], c = runs[1] + b, d = runs[2] + c, e = runs[3] + d;
+	
+	if ( b == e ) {
+		return;
+	} else if ( b == c || !less(array[b], array[b - 1]) ) {
+		std::move(array, array + c, buffer + a);
+	} else if ( less(array[c - 1], array[a]) ) {
+		std::move(array + b, array + c, buffer + a);
+		std::move(array, array + b, buffer + (a + c - b));
+	} else {
+		coleMergeIntoSorted(array, buffer, c - a, b - a, less);
+	}
+	
+	if ( c == e ) {
+		//
+	} else if ( d == e || !less(array[d], array[d - 1]) ) {
+		std::move(array + c, array + e, buffer + c);
+	} else if ( less(array[e - 1], array[c]) ) {
+		std::move(array + d, array + e, buffer + c);
+		std::move(array + c, array + d, buffer + (c + e - d));
+	} else {
+		coleMergeIntoSorted(array + c, buffer + c, e - c, d - c, less);
+	}
+	
+	coleMergeIntoSorted(buffer, array, e, c, less);
+}
+
+template <typename Iterator, typename Element, typename Less>
+std::size_t coleSeek(Iterator array, Element *buffer, std::size_t count, std::size_t minimum, Less &less) {
+	if ( count < 2 ) {
+		return count;
+	}
+	
+	std::size_t minimumRun = 8;
+	std::size_t runs[4] = {0, 0, 0, 0};
+	std::size_t run = 0, sum = 0, seek, limit;
+	unsigned i;
+	bool isReversed;
+	
+	for ( i = 0 ; i < 4 && run + 1 < count ; ++i ) {
+		isReversed = less(array[run + 1], array[run]);
+		run += 2;
+		
+		if ( isReversed ) {
+			while ( run < count && less(array[run], array[run - 1]) ) {
+				run += 1;
+			}
+			
+			std::reverse(array + sum, array + run);
+		} else {
+			while ( run < count && !less(array[run], array[run - 1]) ) {
+				run += 1;
+			}
+		}
+		
+		if ( run < sum + minimumRun && run + 1 < minimum ) {
+			limit = count < sum + minimumRun ? count - sum : minimumRun;
+			
+			binaryInsertionSort(array + sum, limit, run - sum, less);
+			
+			run = sum + limit;
+		}
+		
+		runs[i] = run - sum;
+		sum = run;
+	}
+	
+	if ( run + 1 == count ) {
+		limit = runs[i - 1];
+		
+		if ( i < 4 ) {
+			runs[i] = 1;
+			i += 1;
+		} else {
+			binaryInsertionSort(array + (sum - limit), limit + 1, limit, less);
+			runs[i - 1] += 1;
+		}
+		
+		run += 1;
+		sum = run;
+	}
+	
+	coleMergeSorted(array, runs, buffer, less);
+	
+	while ( run < minimum ) {
+		runs[0] = run;
+		runs[2] = 0;
+		runs[3] = 0;
+		seek = run > minimumRun * 4 ? run * 3 / 4 : run;
+		
+		for ( i = 1 ; i < 4 && sum < count ; ++i ) {
+			limit = count - sum;
+			seek = limit < seek ? limit : seek;
+			
+			run = coleSeek(array + sum, buffer, limit, seek, less);
+			sum += run;
+			runs[i] = run;
+		}
+		
+		if ( i == 3 && runs[2] < runs[0] && (runs[0] + runs[1] + 3) >> ((runs[0] + runs[1]) / runs[2]) > 1 ) {
+			runs[3] = runs[2];
+			runs[2] = runs[1];
+			runs[1] = 0;
+			i = 4;
+		}
+		
+		coleMergeSorted(array, runs, buffer, less);
+		run = sum;
+	}
+	
+	return sum;
+}
+
+//	MARK: - Tumble Merge Sort
+
+enum { kTumbleMaximumRuns = 32 };
+
+template <typename Input>
+struct IteratorCount {
+	Input p;
+	std::size_t n;
+};
+
+///	True when a sorts before b, or when they are equivalent and a is from an earlier run
+template <typename Input, typename Less>
+bool tumbleStableIsLess(Input a, Input b, Less &less) {
+	return less(*a, *b) || (!less(*b, *a) && a < b);
+}
+
+template <typename Input, typename Output, typename Less>
+std::size_t tumbleMergeIntoSorted(Input unmerged, Output merged, std::size_t runs[], unsigned runCount, Less &less) {
+	std::size_t index, total = 0;
+	IteratorCount<Input> pointers[kTumbleMaximumRuns];
+	unsigned i, m, n, o, valid = runCount;
+	
+	for ( i = 0 ; i < valid ; ++i ) {
+		index = runs[i];
+		pointers[i].p = unmerged + total;
+		pointers[i].n = index;
+		total += index;
+	}
+	
+	for ( i = 1 ; i < valid ; ++i ) {
+		m = 1;
+		n = i;
+		
+		while ( m <= n ) {
+			o = (m + n) / 2;
+			
+			if ( less(*pointers[i].p, *pointers[o - 1].p) ) {
+				n = o - 1;
+			} else {
+				m = o + 1;
+			}
+		}
+		
+		if ( m <= i ) {
+			std::rotate(pointers + (m - 1), pointers + i, pointers + (i + 1));
+		}
+	}
+	
+	for ( index = 0 ; index < total ; ++index ) {
+		merged[index] = std::move(*pointers[0].p);
+		
+		pointers[0].n -= 1;
+		
+		if ( pointers[0].n > 0 ) {
+			++pointers[0].p;
+			
+			m = 1;
+			n = valid - 1;
+			
+			while ( m <= n ) {
+				o = (m + n) / 2;
+				
+				if ( tumbleStableIsLess(pointers[0].p, pointers[o].p, less) ) {
+					n = o - 1;
+				} else {
+					m = o + 1;
+				}
+			}
+			
+			if ( m > 1 ) {
+				std::rotate(pointers, pointers + 1, pointers + m);
+			}
+		} else {
+			valid -= 1;
+			
+			std::rotate(pointers, pointers + 1, pointers + (valid + 1));
+		}
+	}
+	
+	return total;
+}
+
+template <typename Input, typename Output, typename Less>
+unsigned tumbleMergeSorted(Input unmerged, std::size_t runs[], unsigned count, Output merged, Less &less) {
+	if ( count > 2 ) {
+		tumbleMergeIntoSorted(unmerged, merged, runs, count, less);
+	} else if ( count > 1 ) {
+		coleMergeIntoSorted(unmerged, merged, runs[0] + runs[1], runs[0], less);
+	} else {
+		return 0;
+	}
+	
+	return 1;
+}
+
+template <typename Iterator, typename Element, typename Less>
+std::size_t tumbleMergeSeek(Iterator array, Element *buffer, std::size_t count, std::size_t minimum, unsigned juggling, Less &less) {
+	if ( count < 2 ) {
+		if ( juggling && count > 0 ) {
+			*buffer = std::move(*array);
+		}
+		
+		return count;
+	}
+	
+	std::size_t runs[kTumbleMaximumRuns];
+	std::size_t run = 0, sum = 0, seek, limit;
+	unsigned i, resultsInBuffer;
+	bool isReversed;
+	
+	for ( i = 0 ; i < kTumbleMaximumRuns && run + 1 < count ; ++i ) {
+		isReversed = less(array[run + 1], array[run]);
+		run += 2;
+		
+		while ( run < count && isReversed == less(array[run], array[run - 1]) ) {
+			run += 1;
+		}
+		
+		if ( isReversed ) {
+			std::reverse(array + sum, array + run);
+		}
+		
+		runs[i] = run - sum;
+		sum = run;
+	}
+	
+	if ( run + 1 == count ) {
+		limit = runs[i - 1];
+		
+		if ( i < kTumbleMaximumRuns && limit > 8 ) {
+			runs[i] = 1;
+			i += 1;
+		} else {
+			binaryInsertionSort(array + (sum - limit), limit + 1, limit, less);
+			runs[i - 1] += 1;
+		}
+		
+		run += 1;
+		sum = run;
+	}
+	
+	resultsInBuffer = tumbleMergeSorted(array, runs, i, buffer, less);
+	
+	while ( run < minimum ) {
+		runs[0] = run;
+		seek = run * 3 / 4;
+		
+		for ( i = 1 ; i < kTumbleMaximumRuns && sum < count ; ++i ) {
+			limit = count - sum;
+			seek = limit < seek ? limit : seek;
+			
+			run = tumbleMergeSeek(array + sum, buffer + sum, limit, seek, resultsInBuffer, less);
+			sum += run;
+			runs[i] = run;
+		}
+		
+		if ( resultsInBuffer ) {
+			resultsInBuffer ^= tumbleMergeSorted(buffer, runs, i, array, less);
+		} else {
+			resultsInBuffer ^= tumbleMergeSorted(array, runs, i, buffer, less);
+		}
+		
+		run = sum;
+	}
+	
+	if ( resultsInBuffer && !juggling ) {
+		std::move(buffer, buffer + sum, array);
+	} else if ( juggling && !resultsInBuffer ) {
+		std::move(array, array + sum, buffer);
+	}
+	
+	return sum;
+}
+
+//	MARK: - Quick Sort
+
+template <typename Iterator, typename Less>
+void heapSift(Iterator array, std::size_t start, std::size_t end, Less &less) {
+	typedef typename std::iterator_traits<Iterator>::value_type Element;
+	
+	std::size_t i = start, j = start;
+	std::size_t a, b;
+	unsigned d = 0;
+	
+	while ( j * 2 + 2 <= end ) {
+		if ( less(array[j * 2 + 1], array[j * 2 + 2]) ) {
+			j = j * 2 + 2;
+		} else {
+			j = j * 2 + 1;
+		}
+		d += 1;
+	}
+	
+	while ( j * 2 + 1 <= end ) {
+		j = j * 2 + 1;
+		d += 1;
+	}
+	
+	while ( less(array[j], array[i]) ) {
+		j = (j - 1) / 2;
+		d -= 1;
+	}
+	
+	if ( d > 0 ) {
+		Element t(std::move(array[i]));
+		
+		while ( d --> 0 ) {
+			a = (j + 1 - (static_cast<std::size_t>(1) << d)) >> d;
+			b = (a - 1) >> 1;
+			array[b] = std::move(array[a]);
+		}
+		
+		array[j] = std::move(t);
+	}
+}
+
+///	Heap Sort organizes elements into a heap then extracts elements from the heap in sorted order
+template <typename Iterator, typename Less>
+void heapSort(Iterator array, std::size_t count, Less &less) {
+	if ( count < 2 ) {
+		return;
+	}
+	
+	std::size_t start = count / 2;
+	
+	while ( start > 0 ) {
+		start -= 1;
+		
+		heapSift(array, start, count - 1, less);
+	}
+	
+	std::size_t end = count - 1;
+	
+	while ( end > 0 ) {
+		std::iter_swap(array, array + end);
+		
+		end -= 1;
+		
+		heapSift(array, 0, end, less);
+	}
+}
+
+template <typename Iterator, typename Less>
+std::size_t quickPartition(Iterator array, std::size_t count, Less &less) {
+	std::size_t pivot = count / 2;
+	std::size_t lower = 0, upper = count - 1;
+	
+	if ( less(array[pivot], array[lower]) ) {
+		std::iter_swap(array + pivot, array + lower);
+	}
+	
+	if ( less(array[upper], array[pivot]) ) {
+		std::iter_swap(array + pivot, array + upper);
+		
+		if ( less(array[pivot], array[lower]) ) {
+			std::iter_swap(array + pivot, array + lower);
+		}
+	}
+	
+	for ( ;; ) {
+		do {
+			lower += 1;
+		} while ( less(array[lower], array[pivot]) );
+		
+		do {
+			upper -= 1;
+		} while ( less(array[pivot], array[upper]) );
+		
+		if ( lower < upper ) {
+			std::iter_swap(array + lower, array + upper);
+			
+			if ( pivot == lower ) {
+				pivot = upper;
+			} else if ( pivot == upper ) {
+				pivot = lower;
+			}
+		} else {
+			break;
+		}
+	}
+	
+	return 1 + upper;
+}
+
+/// Self balancing quick sort that use an alternate sorting algorithm on affected regions after several pivots in a row are imbalanced
+template <typename Iterator, typename Less>
+void balancingQuickSort(Iterator array, std::size_t count, unsigned imbalances, Less &less) {
+	if ( count < 2 ) {
+		return;
+	} else if ( count < 16 ) {
+		binaryInsertionSort(array, count, 1, less);
+	} else if ( imbalances > 4 ) {
+		heapSort(array, count, less);
+	} else {
+		std::size_t pivot = quickPartition(array, count, less);
+		std::size_t ratio = 12;
+		
+		imbalances = count > ratio * (count - pivot - 1 < pivot ? count - pivot - 1 : pivot) ? imbalances + 1 : 0;
+		
+		balancingQuickSort(array, pivot, imbalances, less);
+		balancingQuickSort(array + pivot, count - pivot, imbalances, less);
+	}
+}
+
+} // namespace detail
+
+//	MARK: - Sorting
+
+///	Stable merge sort that operates on four runs at a time, starting with natural ascending or descending runs
+template <typename Iterator, typename Less>
+void cole_sort(Iterator first, Iterator last, Less less) {
+	typedef typename std::iterator_traits<Iterator>::value_type Element;
+	
+	std::size_t count = static_cast<std::size_t>(last - first);
+	
+	if ( count < 8 ) {
+		detail::binaryInsertionSort(first, count, 1, less);
+		return;
+	}
+	
+	detail::Buffer<Element> buffer(first, count);
+	
+	detail::coleSeek(first, buffer.data(), count, count, less);
+}
+
+template <typename Iterator>
+void cole_sort(Iterator first, Iterator last) {
+	cole_sort(first, last, std::less<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+///	Stable merge sort that operates on many runs at a time, starting with natural ascending or descending runs
+template <typename Iterator, typename Less>
+void tumble_merge_sort(Iterator first, Iterator last, Less less) {
+	typedef typename std::iterator_traits<Iterator>::value_type Element;
+	
+	std::size_t count = static_cast<std::size_t>(last - first);
+	
+	if ( count < 16 ) {
+		detail::binaryInsertionSort(first, count, 1, less);
+		return;
+	}
+	
+	detail::Buffer<Element> buffer(first, count);
+	
+	detail::tumbleMergeSeek(first, buffer.data(), count, count, 0, less);
+}
+
+template <typename Iterator>
+void tumble_merge_sort(Iterator first, Iterator last) {
+	tumble_merge_sort(first, last, std::less<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+///	Unstable in place quick sort that falls back to heap sort after several imbalanced partitions in a row
+template <typename Iterator, typename Less>
+void balancing_quick_sort(Iterator first, Iterator last, Less less) {
+	detail::balancingQuickSort(first, static_cast<std::size_t>(last - first), 0, less);
+}
+
+template <typename Iterator>
+void balancing_quick_sort(Iterator first, Iterator last) {
+	balancing_quick_sort(first, last, std::less<typename std::iterator_traits<Iterator>::value_type>());
+}
+
+} // namespace scortch
+
+#endif /* sort_hpp */